@@ -0,0 +1,239 @@
+/*
+ * ui_bench.c
+ *
+ * Replays a scripted D-pad sequence against the SquareLine screens
+ * (panel moves on ui_Screen1, ENTER into the roller on ui_Screen2,
+ * UP/DOWN scrolls and back) and reports, per step, the time spent
+ * handling the key, rendering, flushing, the redrawn area and the
+ * heap peak.
+ *
+ * The display is a headless 160x128 RGB565 one configured like the
+ * fbdev backend (partial mode, two buffers), the flush copies the
+ * rows into a shadow framebuffer the way lv_linux_fbdev does.
+ *
+ * Usage: ui_bench [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+#include <sys/resource.h>
+#include <linux/input.h>
+
+#include "lvgl/lvgl.h"
+#include "src/ui/ui.h"
+#include "src/controller.h"
+
+#define BENCH_DEFAULT_ITERATIONS 100
+#define BENCH_BUF_LINES          LV_LINUX_FBDEV_BUFFER_SIZE
+
+typedef struct {
+    const char *name;
+    uint16_t code;
+} BenchStep;
+
+// Balanced script: ends on the same panel, screen and mapping it started with
+static const BenchStep script[] = {
+    {"panel right",      KEY_RIGHT},
+    {"panel right",      KEY_RIGHT},
+    {"panel down",       KEY_DOWN},
+    {"panel left",       KEY_LEFT},
+    {"panel left",       KEY_LEFT},
+    {"panel up",         KEY_UP},
+    {"enter (roller)",   KEY_ENTER},
+    {"roller down",      KEY_DOWN},
+    {"roller down",      KEY_DOWN},
+    {"roller up",        KEY_UP},
+    {"roller up",        KEY_UP},
+    {"enter (back)",     KEY_ENTER},
+};
+
+#define NUM_STEPS (sizeof(script)/sizeof(script[0]))
+
+typedef struct {
+    uint64_t handle_ns;
+    uint64_t render_ns;
+    uint64_t flush_ns;
+    uint64_t render_max_ns;
+    uint64_t area_px;
+    uint32_t flushes;
+    size_t heap_peak;
+} StepStats;
+
+static StepStats stats[NUM_STEPS];
+
+static uint8_t *shadow_fb;
+static uint32_t shadow_stride;
+
+// Per-refresh accumulators filled by the flush callback
+static uint64_t refr_flush_ns;
+static uint64_t refr_area_px;
+static uint32_t refr_flushes;
+static size_t refr_heap_peak;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint32_t bench_tick(void) {
+    return (uint32_t)(now_ns() / 1000000ull);
+}
+
+static size_t heap_in_use(void) {
+    struct mallinfo2 mi = mallinfo2();
+    return mi.uordblks + mi.hblkhd;
+}
+
+static void sample_heap(void) {
+    size_t used = heap_in_use();
+    if (used > refr_heap_peak) refr_heap_peak = used;
+}
+
+static void bench_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    uint64_t t0 = now_ns();
+
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+    uint32_t px_size = lv_color_format_get_size(lv_display_get_color_format(disp));
+    uint8_t *dst = shadow_fb + area->y1 * shadow_stride + area->x1 * px_size;
+
+    for (int32_t y = 0; y < h; y++) {
+        memcpy(dst, px_map, w * px_size);
+        dst += shadow_stride;
+        px_map += w * px_size;
+    }
+
+    sample_heap();
+    refr_area_px += (uint64_t)w * h;
+    refr_flushes++;
+    refr_flush_ns += now_ns() - t0;
+
+    lv_display_flush_ready(disp);
+}
+
+static lv_display_t *bench_display_create(int32_t hor_res, int32_t ver_res) {
+    lv_display_t *disp = lv_display_create(hor_res, ver_res);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+
+    uint32_t px_size = lv_color_format_get_size(LV_COLOR_FORMAT_RGB565);
+    uint32_t lines = BENCH_BUF_LINES < ver_res ? BENCH_BUF_LINES : ver_res;
+    uint32_t buf_size = hor_res * px_size * lines;
+
+    uint8_t *buf1 = malloc(buf_size);
+    uint8_t *buf2 = malloc(buf_size);
+    shadow_stride = hor_res * px_size;
+    shadow_fb = calloc(ver_res, shadow_stride);
+    if (buf1 == NULL || buf2 == NULL || shadow_fb == NULL) {
+        fprintf(stderr, "Out of memory allocating draw buffers\n");
+        exit(EXIT_FAILURE);
+    }
+
+    lv_display_set_buffers(disp, buf1, buf2, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, bench_flush);
+    return disp;
+}
+
+// Forces the pending invalidations to be rendered and returns the time spent in lv_refr_now
+static uint64_t bench_refresh(lv_display_t *disp) {
+    refr_flush_ns = 0;
+    refr_area_px = 0;
+    refr_flushes = 0;
+    refr_heap_peak = heap_in_use();
+
+    uint64_t t0 = now_ns();
+    lv_refr_now(disp);
+    uint64_t elapsed = now_ns() - t0;
+
+    sample_heap();
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : BENCH_DEFAULT_ITERATIONS;
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *env_w = getenv("LV_SIM_WINDOW_WIDTH");
+    const char *env_h = getenv("LV_SIM_WINDOW_HEIGHT");
+
+    lv_init();
+    lv_tick_set_cb(bench_tick);
+
+    lv_display_t *disp = bench_display_create(atoi(env_w ? env_w : "160"), atoi(env_h ? env_h : "128"));
+
+    uint64_t t0 = now_ns();
+    ui_init();
+    uint64_t init_ns = now_ns() - t0;
+
+    // Same startup state as main()
+    select_panel(0);
+    setup_sound_roller(ui_Roller1);
+
+    uint64_t first_ns = bench_refresh(disp);
+    printf("ui_init: %.1f us, first frame: %.1f us (flush %.1f us, %llu px)\n",
+           init_ns / 1000.0, (first_ns - refr_flush_ns) / 1000.0, refr_flush_ns / 1000.0,
+           (unsigned long long)refr_area_px);
+
+    for (int it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < NUM_STEPS; i++) {
+            StepStats *st = &stats[i];
+
+            uint64_t h0 = now_ns();
+            handle_key_event(script[i].code, 1);
+            handle_key_event(script[i].code, 0);
+            st->handle_ns += now_ns() - h0;
+
+            uint64_t refr_ns = bench_refresh(disp);
+            uint64_t render_ns = refr_ns - refr_flush_ns;
+
+            st->render_ns += render_ns;
+            st->flush_ns += refr_flush_ns;
+            st->area_px += refr_area_px;
+            st->flushes += refr_flushes;
+            if (render_ns > st->render_max_ns) st->render_max_ns = render_ns;
+            if (refr_heap_peak > st->heap_peak) st->heap_peak = refr_heap_peak;
+        }
+    }
+
+    printf("\n%d iterations, averages per step\n", iterations);
+    printf("%-3s %-16s %10s %10s %10s %10s %9s %8s %9s\n",
+           "#", "step", "key_us", "render_us", "max_us", "flush_us", "area_px", "flushes", "heap_kib");
+
+    StepStats total = {0};
+    for (size_t i = 0; i < NUM_STEPS; i++) {
+        StepStats *st = &stats[i];
+        printf("%-3zu %-16s %10.1f %10.1f %10.1f %10.1f %9llu %8.1f %9.1f\n",
+               i, script[i].name,
+               st->handle_ns / 1000.0 / iterations,
+               st->render_ns / 1000.0 / iterations,
+               st->render_max_ns / 1000.0,
+               st->flush_ns / 1000.0 / iterations,
+               (unsigned long long)(st->area_px / iterations),
+               (double)st->flushes / iterations,
+               st->heap_peak / 1024.0);
+
+        total.handle_ns += st->handle_ns;
+        total.render_ns += st->render_ns;
+        total.flush_ns += st->flush_ns;
+        total.area_px += st->area_px;
+        if (st->heap_peak > total.heap_peak) total.heap_peak = st->heap_peak;
+    }
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+
+    printf("\nscript total: key %.1f us, render %.1f us, flush %.1f us, %llu px redrawn\n",
+           total.handle_ns / 1000.0 / iterations,
+           total.render_ns / 1000.0 / iterations,
+           total.flush_ns / 1000.0 / iterations,
+           (unsigned long long)(total.area_px / iterations));
+    printf("heap peak: %.1f KiB, max RSS: %ld KiB\n", total.heap_peak / 1024.0, ru.ru_maxrss);
+
+    return 0;
+}
@@ -0,0 +1,36 @@
+#!/bin/sh
+
+# Builds the default and the min (PROFILE=min) profiles and compares
+# binary size and startup time. Startup is measured with ui_bench,
+# which runs lv_init and ui_init and renders the first frame without
+# the ADC; on the board, main prints its own startup timeline.
+
+RUNS=${RUNS:-5}
+JOBS=${JOBS:-$(nproc)}
+
+make -j"$JOBS" default bench || exit 1
+make -j"$JOBS" PROFILE=min default bench || exit 1
+
+for dir in build build/min
+do
+    echo "== $dir"
+    size "$dir/bin/main" "$dir/bin/ui_bench"
+
+    best=0
+    i=0
+    while test $i -lt "$RUNS"
+    do
+        start=$(date +%s%N)
+        out=$("$dir/bin/ui_bench" 1 | head -n 1)
+        end=$(date +%s%N)
+        wall=$(( (end - start) / 1000 ))
+        if test $best -eq 0 || test $wall -lt $best
+        then
+            best=$wall
+            best_out=$out
+        fi
+        i=$((i + 1))
+    done
+    echo "$best_out"
+    echo "process start to exit: $best us (best of $RUNS)"
+done
@@ -0,0 +1,23 @@
+#!/bin/sh
+
+# Builds a drumkit.dsp variant as a shared object for a running synth host
+# to swap in (/synth/load, synth/dsp_swap.h). The host runs it itself when
+# it is given a .dsp, `make synth-plugin DSP=...` for a .so to keep.
+#
+# usage: dsp_plugin.sh variant.dsp output.so
+
+if test $# -ne 2
+then
+    echo "usage: dsp_plugin.sh variant.dsp output.so"
+    exit 1
+fi
+
+set -e
+
+ARCH="$(dirname "$0")/../synth/plugin.cpp"
+CPP="$(mktemp --suffix=.cpp)"
+trap 'rm -f "$CPP"' EXIT
+
+# Own class name, the host's built-in DSP is a mydsp too
+faust -i -cn plugindsp -a "$ARCH" "$1" -o "$CPP"
+${CXX:-c++} -O3 -fPIC -shared -fvisibility=hidden -o "$2" "$CPP"
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+
+# Cuts an lv_font_conv generated LVGL font (e.g. lvgl/src/font/lv_font_montserrat_14.c)
+# down to the characters the UI can actually show.
+#
+# The characters come from the C string literals of the given source files.
+# FILE:SYMBOL only takes the literals of that symbol's initializer, so
+# src/sounds.c:sound_names picks the roller options without the printf
+# format strings around them.
+#
+# usage: gen_font_subset.py font.c name output.c source[:symbol]...
+
+import re
+import sys
+
+
+def parse_int(text):
+    return int(text, 0)
+
+
+def strip_source(path):
+    """Source without comments and preprocessor lines (#error messages are not UI text)"""
+    with open(path) as f:
+        src = f.read()
+
+    src = re.sub(r'/\*.*?\*/', '', src, flags=re.S)
+    src = re.sub(r'//[^\n]*', '', src)
+    src = '\n'.join(l for l in src.split('\n') if not l.lstrip().startswith('#'))
+    return src
+
+
+def literals_from(spec):
+    path, _, symbol = spec.partition(':')
+    src = strip_source(path)
+
+    if symbol:
+        m = re.search(re.escape(symbol) + r'\s*(\[[^\]]*\])?\s*=\s*\{(.*?)\};', src, flags=re.S)
+        if m is None:
+            sys.exit('gen_font_subset: %s not found in %s' % (symbol, path))
+        src = m.group(2)
+
+    chars = set()
+    for lit in re.findall(r'"((?:[^"\\]|\\.)*)"', src):
+        lit = bytes(lit, 'utf-8').decode('unicode_escape')
+        chars.update(c for c in lit if c >= ' ')
+    return chars
+
+
+def parse_font(path):
+    with open(path) as f:
+        src = f.read()
+
+    bitmap = re.search(r'glyph_bitmap\[\]\s*=\s*\{(.*?)\n\};', src, flags=re.S).group(1)
+    glyphs = []
+    for m in re.finditer(r'/\* U\+([0-9A-F]+) .*?\*/\n(.*?)(?=\n\s*/\* U\+|\Z)', bitmap, flags=re.S):
+        data = [parse_int(v) for v in re.findall(r'0x[0-9a-f]+', m.group(2))]
+        glyphs.append((int(m.group(1), 16), data))
+
+    dsc_block = re.search(r'glyph_dsc\[\]\s*=\s*\{(.*?)\n\};', src, flags=re.S).group(1)
+    dscs = []
+    for m in re.finditer(r'\{([^{}]*)\}', dsc_block):
+        dscs.append(dict((k, int(v)) for k, v in re.findall(r'\.(\w+)\s*=\s*(-?\d+)', m.group(1))))
+
+    # Glyph ids follow the order of the bitmap blocks, id 0 is reserved
+    if len(dscs) != len(glyphs) + 1:
+        sys.exit('gen_font_subset: %s: %d glyph descriptors for %d bitmaps'
+                 % (path, len(dscs), len(glyphs)))
+
+    def array(name, cast):
+        m = re.search(name + r'\[\]\s*=\s*\{(.*?)\};', src, flags=re.S)
+        return [cast(v) for v in re.findall(r'-?(?:0x)?[0-9a-f]+', m.group(1))] if m else None
+
+    def field(name):
+        m = re.search(r'\.' + name + r'\s*=\s*(-?\w+)', src)
+        return m.group(1) if m else None
+
+    size = re.search(r'Size: (\d+) px', src)
+
+    font = {
+        'size': size.group(1) if size else '?',
+        'glyphs': glyphs,
+        'dscs': dscs,
+        'bpp': int(field('bpp')),
+        'line_height': int(field('line_height')),
+        'base_line': int(field('base_line')),
+        'underline_position': int(field('underline_position') or 0),
+        'underline_thickness': int(field('underline_thickness') or 0),
+        'kern_scale': int(field('kern_scale') or 16),
+        'kern_left': array('kern_left_class_mapping', parse_int),
+        'kern_right': array('kern_right_class_mapping', parse_int),
+        'kern_values': array('kern_class_values', parse_int),
+        'left_class_cnt': field('left_class_cnt'),
+        'right_class_cnt': field('right_class_cnt'),
+    }
+
+    if field('bitmap_format') not in (None, '0'):
+        sys.exit('gen_font_subset: %s: only uncompressed fonts are supported' % path)
+    return font
+
+
+def c_array(values, per_line=8):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(values[i:i + per_line]))
+    return ',\n'.join(lines)
+
+
+def emit(font, name, chars, source, out):
+    by_cp = dict((cp, (gid + 1, data)) for gid, (cp, data) in enumerate(font['glyphs']))
+    missing = sorted(c for c in chars if ord(c) not in by_cp)
+    if missing:
+        sys.exit('gen_font_subset: %s has no glyph for %r' % (source, ''.join(missing)))
+
+    cps = sorted(ord(c) for c in chars)
+    old_ids = [by_cp[cp][0] for cp in cps]
+
+    o = []
+    o.append('/*******************************************************************************')
+    o.append(' * Generated by scripts/gen_font_subset.py from %s, do not edit' % source)
+    o.append(' * Size: %s px, Bpp: %d, %d glyphs' % (font['size'], font['bpp'], len(cps)))
+    o.append(' * Characters: %s' % ''.join(chr(cp) for cp in cps).replace('*/', '* /'))
+    o.append(' ******************************************************************************/')
+    o.append('')
+    o.append('#include "../ui.h"')
+    o.append('')
+    o.append('/*Store the image of the glyphs*/')
+    o.append('static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {')
+    blocks = []
+    index = 0
+    dscs = ['    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */']
+    for cp, gid in zip(cps, old_ids):
+        data = by_cp[cp][1]
+        d = font['dscs'][gid]
+        block = '    /* U+%04X "%s" */' % (cp, chr(cp).replace('\\', '\\\\').replace('"', '\\"'))
+        for i in range(0, len(data), 8):
+            block += '\n    ' + ', '.join('0x%x' % v for v in data[i:i + 8]) + ','
+        blocks.append(block)
+        dscs.append('    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d}'
+                    % (index, d['adv_w'], d['box_w'], d['box_h'], d['ofs_x'], d['ofs_y']))
+        index += len(data)
+    o.append('\n\n'.join(blocks))
+    o.append('};')
+    o.append('')
+    o.append('static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {')
+    o.append(',\n'.join(dscs))
+    o.append('};')
+    o.append('')
+    # One directly indexed range (FORMAT0_FULL) so the lookup stays O(1) like the
+    # ASCII range of the full font, a 0 offset past the first code point is "missing"
+    length = cps[-1] - cps[0] + 1
+    if len(cps) > 256 or length > 1024:
+        sys.exit('gen_font_subset: %d characters over %d code points, too sparse for one range'
+                 % (len(cps), length))
+    ofs = [0] * length
+    for i, cp in enumerate(cps):
+        ofs[cp - cps[0]] = i
+    o.append('static const uint8_t glyph_id_ofs_list_0[] = {')
+    o.append(c_array([str(v) for v in ofs], 16))
+    o.append('};')
+    o.append('')
+    o.append('static const lv_font_fmt_txt_cmap_t cmaps[] = {')
+    o.append('    {')
+    o.append('        .range_start = %d, .range_length = %d, .glyph_id_start = 1,' % (cps[0], length))
+    o.append('        .unicode_list = NULL, .glyph_id_ofs_list = glyph_id_ofs_list_0, .list_length = %d, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL'
+             % length)
+    o.append('    }')
+    o.append('};')
+    o.append('')
+
+    kern = font['kern_left'] is not None
+    if kern:
+        left = [0] + [font['kern_left'][gid] for gid in old_ids]
+        right = [0] + [font['kern_right'][gid] for gid in old_ids]
+        o.append('static const uint8_t kern_left_class_mapping[] = {')
+        o.append(c_array([str(v) for v in left]))
+        o.append('};')
+        o.append('')
+        o.append('static const uint8_t kern_right_class_mapping[] = {')
+        o.append(c_array([str(v) for v in right]))
+        o.append('};')
+        o.append('')
+        o.append('static const int8_t kern_class_values[] = {')
+        o.append(c_array([str(v) for v in font['kern_values']]))
+        o.append('};')
+        o.append('')
+        o.append('static const lv_font_fmt_txt_kern_classes_t kern_classes = {')
+        o.append('    .class_pair_values   = kern_class_values,')
+        o.append('    .left_class_mapping  = kern_left_class_mapping,')
+        o.append('    .right_class_mapping = kern_right_class_mapping,')
+        o.append('    .left_class_cnt      = %s,' % font['left_class_cnt'])
+        o.append('    .right_class_cnt     = %s,' % font['right_class_cnt'])
+        o.append('};')
+        o.append('')
+
+    o.append('static const lv_font_fmt_txt_dsc_t font_dsc = {')
+    o.append('    .glyph_bitmap = glyph_bitmap,')
+    o.append('    .glyph_dsc = glyph_dsc,')
+    o.append('    .cmaps = cmaps,')
+    o.append('    .kern_dsc = %s,' % ('&kern_classes' if kern else 'NULL'))
+    o.append('    .kern_scale = %d,' % font['kern_scale'])
+    o.append('    .cmap_num = 1,')
+    o.append('    .bpp = %d,' % font['bpp'])
+    o.append('    .kern_classes = %d,' % (1 if kern else 0))
+    o.append('    .bitmap_format = 0,')
+    o.append('};')
+    o.append('')
+    o.append('const lv_font_t %s = {' % name)
+    o.append('    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,')
+    o.append('    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,')
+    o.append('    .line_height = %d,' % font['line_height'])
+    o.append('    .base_line = %d,' % font['base_line'])
+    o.append('    .subpx = LV_FONT_SUBPX_NONE,')
+    o.append('    .underline_position = %d,' % font['underline_position'])
+    o.append('    .underline_thickness = %d,' % font['underline_thickness'])
+    o.append('    .dsc = &font_dsc')
+    o.append('};')
+
+    with open(out, 'w') as f:
+        f.write('\n'.join(o) + '\n')
+
+
+def main():
+    if len(sys.argv) < 5:
+        sys.exit('usage: gen_font_subset.py font.c name output.c source[:symbol]...')
+
+    font_path, name, out = sys.argv[1:4]
+    chars = set(' ')
+    for spec in sys.argv[4:]:
+        chars |= literals_from(spec)
+
+    emit(parse_font(font_path), name, chars, font_path, out)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,105 @@
+#!/bin/sh
+
+# Generates a trimmed copy of lv_conf.h for 'make PROFILE=min'
+# Widgets are kept only if an lv_<widget>_create call appears in the
+# sources, Montserrat sizes only if the font is referenced (or is
+# LV_FONT_DEFAULT). When the UI has a glyph subset of the default font
+# (scripts/gen_font_subset.py) LV_FONT_DEFAULT points to it instead, so
+# the full font is dropped too. Vector graphics, decoders, compressors, the
+# examples and the demos are switched off.
+
+if test $# -lt 3
+then
+    echo "usage: gen_min_conf.sh lv_conf_path output_path source_dir..."
+    exit 1
+fi
+
+CONF="$1"
+OUT="$2"
+shift 2
+
+# Widgets listed in the WIDGETS section of lv_conf.h
+WIDGETS="ANIMIMG ARC ARCLABEL BAR BUTTON BUTTONMATRIX CALENDAR CANVAS CHART CHECKBOX DROPDOWN IMAGE
+         IMAGEBUTTON KEYBOARD LABEL LED LINE LIST LOTTIE MENU MSGBOX ROLLER SCALE SLIDER SPAN SPINBOX
+         SPINNER SWITCH TABLE TABVIEW TEXTAREA TILEVIEW WIN"
+
+# Widgets that need another one enabled ("Requires:" notes in lv_conf.h)
+DEPS="SLIDER:BAR ROLLER:LABEL DROPDOWN:LABEL IMAGE:LABEL TEXTAREA:LABEL IMAGEBUTTON:IMAGE"
+
+# Features the drum UI does not use
+FEATURES="VECTOR_GRAPHIC THORVG_INTERNAL LZ4_INTERNAL RLE LODEPNG BMP TJPGD QRCODE BARCODE TINY_TTF
+          IMGFONT THEME_SIMPLE THEME_MONO FLEX GRID FS_STDIO ST7735"
+
+USED=$(grep -rhoE "lv_[a-z0-9]+_create" "$@" | sed -E 's/lv_(.*)_create/\1/' | tr 'a-z' 'A-Z' | sort -u)
+for dep in $DEPS
+do
+    if echo "$USED" | grep -qx "${dep%%:*}"
+    then
+        USED="$USED
+${dep#*:}"
+    fi
+done
+USED=$(echo "$USED" | sort -u)
+
+DEFAULT_FONT=$(grep -E "^#define LV_FONT_DEFAULT" "$CONF" | grep -oE "montserrat_[0-9]+")
+DEFAULT_SUBSET="ui_font_${DEFAULT_FONT}_subset"
+if grep -rqs "const lv_font_t $DEFAULT_SUBSET" "$@"
+then
+    DEFAULT_FONT=""
+else
+    DEFAULT_SUBSET=""
+fi
+
+FONTS=$( (grep -rhoE "&lv_font_montserrat_[0-9]+" "$@"; echo "$DEFAULT_FONT") |
+        grep -oE "montserrat_[0-9]+" | sed 's/montserrat_//' | sort -u)
+
+SCRIPT=$(mktemp)
+trap 'rm -f "$SCRIPT" "$OUT.tmp"' EXIT
+
+disable() {
+    printf 's/^([[:space:]]*#define[[:space:]]+%s)[[:space:]]+1([[:space:]]|$)/\\1 0\\2/\n' "$1" >> "$SCRIPT"
+}
+
+for w in $WIDGETS
+do
+    echo "$USED" | grep -qx "$w" || disable "LV_USE_$w"
+done
+
+for size in 8 10 12 14 16 18 20 22 24 26 28 30 32 34 36 38 40 42 44 46 48
+do
+    echo "$FONTS" | grep -qx "$size" || disable "LV_FONT_MONTSERRAT_$size"
+done
+
+for f in $FEATURES
+do
+    disable "LV_USE_$f"
+done
+
+disable "LV_FONT_MONTSERRAT_28_COMPRESSED"
+disable "LV_FONT_DEJAVU_16_PERSIAN_HEBREW"
+disable "LV_FONT_SOURCE_HAN_SANS_SC_16_CJK"
+disable "LV_FONT_UNSCII_8"
+disable "LV_BUILD_EXAMPLES"
+disable "LV_USE_DEMO_[A-Z_]+"
+
+if test -n "$DEFAULT_SUBSET"
+then
+    printf 's/^#define LV_FONT_CUSTOM_DECLARE.*/#define LV_FONT_CUSTOM_DECLARE LV_FONT_DECLARE(%s)/\n' "$DEFAULT_SUBSET" >> "$SCRIPT"
+    printf 's/^#define LV_FONT_DEFAULT .*/#define LV_FONT_DEFAULT \&%s/\n' "$DEFAULT_SUBSET" >> "$SCRIPT"
+fi
+
+mkdir -p "$(dirname "$OUT")"
+{
+    echo "/* Generated by scripts/gen_min_conf.sh from $CONF, do not edit */"
+    echo "/* Widgets: $(for w in $WIDGETS; do echo "$USED" | grep -qx "$w" && printf '%s ' "$w"; done)*/"
+    echo "/* Montserrat sizes: $(echo ${FONTS:-none})${DEFAULT_SUBSET:+, default font: $DEFAULT_SUBSET} */"
+    sed -E -f "$SCRIPT" "$CONF"
+} > "$OUT.tmp"
+
+# Keep the old file (and its timestamp) when nothing changed so LVGL is not rebuilt
+if cmp -s "$OUT.tmp" "$OUT"
+then
+    rm -f "$OUT.tmp"
+else
+    mv "$OUT.tmp" "$OUT"
+fi
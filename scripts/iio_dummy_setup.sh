@@ -0,0 +1,24 @@
+#!/bin/sh
+
+# Creates an iio_dummy device and a one pad topology for it, to try the
+# IIO acquisition backend (DRUM_ADC=iio) without the ADS1115 board.
+# in_voltage0 of the dummy plays pad 0. Needs root, configfs and a kernel
+# with CONFIG_IIO_SIMPLE_DUMMY_BUFFER and CONFIG_IIO_HRTIMER_TRIGGER.
+
+NAME=${NAME:-drumdummy}
+TOPO=${TOPO:-/tmp/drumkit-dummy.topo}
+CONFIGFS=/sys/kernel/config
+
+modprobe iio_dummy || exit 1
+modprobe iio-trig-hrtimer || exit 1
+mountpoint -q "$CONFIGFS" || mount -t configfs none "$CONFIGFS" || exit 1
+mkdir -p "$CONFIGFS/iio/devices/dummy/$NAME" || exit 1
+
+cat > "$TOPO" <<TOPO
+# iio_dummy: in_voltage0 as the only pad
+input 0x48 0 0
+channel 0 Kick 0 0
+TOPO
+
+echo "Run: DRUM_ADC=iio DRUM_IIO_DEVICE=$NAME DRUM_TOPOLOGY=$TOPO ./build/bin/main"
+echo "The dummy buffer delivers fixed fake samples, check the SPS line and the scan layout"
@@ -7,17 +7,32 @@
 #include <getopt.h>
 #include <stdint.h>
 #include <time.h> 
+#include <linux/i2c.h>
 
-// ADS1115 default I2C address
-#define DEFAULT_ADS1115_ADDRESS 0x48
+#include "ads1115_reader.h"
+
+// Adapter timeout of one transfer (I2C_TIMEOUT, units of 10 ms), a hung
+// bus fails in 20 ms instead of the adapter default
+#define ADS1115_I2C_TIMEOUT           2
 
 // Configuration settings
 #define ADS1115_CONFIG_OS_SINGLE      0x8000
 #define ADS1115_CONFIG_MUX_SINGLE     0x4000  // 0100 0000 0000 0000 + ch << 12
+#define ADS1115_CONFIG_PGA_SHIFT      9       // PGA code << 9
+#define ADS1115_CONFIG_DR_SHIFT       5       // data rate code << 5
 #define ADS1115_CONFIG_MODE_SINGLE    0x0100  // Single-shot mode
-#define ADS1115_CONFIG_DR_860SPS      0x00E0  // 860 samples per second
 #define ADS1115_CONFIG_CQUE_NONE      0x0003  // Disable comparator
 
+const uint16_t ADS1115_fsr_mv[ADS1115_NUM_PGA] = {6144, 4096, 2048, 1024, 512, 256};
+const uint16_t ADS1115_sps[ADS1115_NUM_DR] = {8, 16, 32, 64, 128, 250, 475, 860};
+
+int ADS1115_dr_code(int sps){
+    for (int dr = 0; dr < ADS1115_NUM_DR; dr++) {
+        if (ADS1115_sps[dr] == sps) return dr;
+    }
+    return -1;
+}
+
 int ADS1115_init(){
     int file;
     char *filename = "/dev/i2c-3";
@@ -26,6 +41,10 @@ int ADS1115_init(){
         perror("Failed to open the i2c bus");
         return -1;
     }
+    // No retries, the caller decides what to do with a failed transfer
+    if (ioctl(file, I2C_TIMEOUT, ADS1115_I2C_TIMEOUT) < 0 || ioctl(file, I2C_RETRIES, 0) < 0) {
+        perror("Setting the i2c timeout");
+    }
     return file;
 }
 
@@ -35,232 +54,99 @@ int ADS1115_exit(int file){
     return 0;
 }
 
-int ADS1115_start_reading(int channel, int file){
-    // Configure the ADC
-    uint8_t config[3] = {0};
+// Split transactions for the scheduler: no I2C_SLAVE switch (the address
+// goes in every message) and no waiting, the caller decides when to poll
 
-    int addr = DEFAULT_ADS1115_ADDRESS;
-
-    if ((channel<0)||(channel>7)){
-        printf("Invalid channel. Must be between 0 and 7. Reading from channel 0 \n");
-        channel = 0;
-    }else if (channel>3){
-        channel -= 4;
-        addr += 1;
-    }
-
-    if (ioctl(file, I2C_SLAVE, addr) < 0) {
-        printf("Failed to communicate with device at address 0x%02x\n", addr);
-        perror("\n");
-        return 1;
-    }
+static int ADS1115_transfer(int file, struct i2c_msg *msgs, int n){
+    struct i2c_rdwr_ioctl_data data = {msgs, n};
+    return ioctl(file, I2C_RDWR, &data) == n ? 0 : -1;
+}
 
+int ADS1115_start(int file, int addr, int ain, int pga, int dr){
     uint16_t config_value = ADS1115_CONFIG_OS_SINGLE |
-                            ADS1115_CONFIG_MUX_SINGLE  | 
-                            ADS1115_CONFIG_MODE_SINGLE | 
-                            ADS1115_CONFIG_DR_860SPS | 
+                            ADS1115_CONFIG_MUX_SINGLE  |
+                            ADS1115_CONFIG_MODE_SINGLE |
+                            ((dr & 7) << ADS1115_CONFIG_DR_SHIFT) |
                             ADS1115_CONFIG_CQUE_NONE |
-                            (channel << 12);
-    
-    config[0] = 1; // Point to the config register
-    config[1] = config_value >> 8;   // Configuration High Byte
-    config[2] = config_value & 0xFF; // Configuration Low Byte
-    
-    //printf("Trying to read from the channel %i. [CONF] = %04x. \n", channel,config_value);
-
-    if (write(file, config, 3) != 3) {
-        perror("Failed to write to the i2c device");
-        ADS1115_exit(file);
-        return 1;
+                            ((pga & 7) << ADS1115_CONFIG_PGA_SHIFT) |
+                            ((ain & 3) << 12);
+    uint8_t config[3] = {1, config_value >> 8, config_value & 0xFF};
+    struct i2c_msg msg = {addr, 0, 3, config};
+
+    if (ADS1115_transfer(file, &msg, 1) < 0) {
+        printf("Failed to start a conversion at 0x%02x: ", addr);
+        perror("");
+        return -1;
     }
     return 0;
 }
 
-int16_t ADS1115_get_result(int channel, int file){
-
-    int addr = DEFAULT_ADS1115_ADDRESS;
+int ADS1115_ready(int file, int addr){
+    // The pointer still points to the config register after ADS1115_start,
+    // so polling the OS bit is a bare 2 byte read
+    uint8_t config_status[2];
+    struct i2c_msg msg = {addr, I2C_M_RD, 2, config_status};
 
-    if ((channel<0)||(channel>7)){
-        printf("Invalid channel. Must be between 0 and 7. Reading from channel 0 \n");
-        channel = 0;
-    }else if (channel>3){
-        channel -= 4;
-        addr += 1;
-    }
-
-    if (ioctl(file, I2C_SLAVE, addr) < 0) {
-        printf("Failed to communicate with device at address %02x", addr);
-        perror("\n");
-        return 1;
+    if (ADS1115_transfer(file, &msg, 1) < 0) {
+        printf("Config read failed at 0x%02x: ", addr);
+        perror("");
+        return -1;
     }
+    return (config_status[0] & 0x80) != 0;
+}
 
-    clock_t start_time = clock();
-    while (1) {
-
-        uint8_t config_reg = 1; // Point to config register
-        if (write(file, &config_reg, 1) != 1) {
-            perror("Failed to set config register pointer");
-            return -1;
-        }
-        
-        // Read config register to check OS bit
-
-        uint8_t config_status[2];
-        if (read(file, config_status, 2) != 2) {
-            perror("Config read failed");
-            return -1;
-        }
-
-        // Check OS bit (bit 15)
-        if (config_status[0] & 0x80) { // MSB of config_status[0] = OS bit
-            break; // Conversion complete
-        }
-
-        // Timeout after 100 ms
-        if ((clock() - start_time) * 1000 / CLOCKS_PER_SEC > 100) {
-            perror("Timeout waiting for conversion");
-            return -1;
-        }
-        usleep(100); // Small delay to avoid busy-waiting
-    }
-        
+int ADS1115_fetch(int file, int addr, int16_t *value){
+    // Pointer write and read with a repeated start, one ioctl
     uint8_t reg = 0;
-    if (write(file, &reg, 1) != 1) {
-        perror("Failed to set register pointer");
-        close(file);
-        return -1;
-    }
-    
     uint8_t data[2];
-    if (read(file, data, 2) != 2) {
-        perror("Failed to read from the i2c device");
-        close(file);
+    struct i2c_msg msgs[2] = {
+        {addr, 0, 1, &reg},
+        {addr, I2C_M_RD, 2, data},
+    };
+
+    if (ADS1115_transfer(file, msgs, 2) < 0) {
+        printf("Failed to read the conversion at 0x%02x: ", addr);
+        perror("");
         return -1;
     }
-    
-    // Convert the result to 16 bits
-    int16_t value = (data[0] << 8) | data[1];
-
-    //printf("Raw value: %d\n", value);
-
-    return value;
+    *value = (data[0] << 8) | data[1];
+    return 0;
 }
 
-int16_t ADS1115_read(int channel, int file){
-    // Configure the ADC
-    uint8_t config[3] = {0};
-
-    int addr = DEFAULT_ADS1115_ADDRESS;
-
-    if ((channel<0)||(channel>7)){
-        printf("Invalid channel. Must be between 0 and 7. Reading from channel 0 \n");
-        channel = 0;
-    }else if (channel>3){
-        channel -= 4;
-        addr += 1;
-    }
-
-    if (ioctl(file, I2C_SLAVE, addr) < 0) {
-        printf("Failed to communicate with device at address %02x", addr);
-        perror("\n");
-        return -1;
-    }
-
-    uint16_t config_value = ADS1115_CONFIG_OS_SINGLE |
-                            ADS1115_CONFIG_MUX_SINGLE  | 
-                            ADS1115_CONFIG_MODE_SINGLE | 
-                            ADS1115_CONFIG_DR_860SPS | 
-                            ADS1115_CONFIG_CQUE_NONE |
-                            (channel << 12);
-    
-    config[0] = 1; // Point to the config register
-    config[1] = config_value >> 8;   // Configuration High Byte
-    config[2] = config_value & 0xFF; // Configuration Low Byte
-    
-    //printf("Trying to read from the channel %i. [CONF] = %04x. \n", channel,config_value);
-
-    if (write(file, config, 3) != 3) {
-        perror("Failed to write to the i2c device");
-        ADS1115_exit(file);
-        return -1;
-    }
-    // Read the conversion result
-    
-    clock_t start_time = clock();
-    while (1) {
-        // Read config register to check OS bit
-
-        uint8_t config_reg = 1; // Point to config register
-        if (write(file, &config_reg, 1) != 1) {
-            perror("Failed to set config register pointer");
-            return -1;
-        }
-
-        uint8_t config_status[2];
-        if (read(file, config_status, 2) != 2) {
-            perror("Config read failed");
-            return -1;
-        }
-
-        // Check OS bit (bit 15)
-        if (config_status[0] & 0x80) { // MSB of config_status[0] = OS bit
-            break; // Conversion complete
-        }
-
-        // Timeout after 100 ms
-        if ((clock() - start_time) * 1000 / CLOCKS_PER_SEC > 100) {
-            perror("Timeout waiting for conversion");
-            return -1;
-        }
-        // usleep(100); // Small delay to avoid busy-waiting
-    }
-        
+int ADS1115_fetch_done(int file, int addr, int ain, int16_t *value){
+    // Config MSB (the pointer is still on it), then the conversion, one
+    // ioctl: a chip whose conversion is not done or whose config is gone
+    // (reset) never hands out a sample
+    uint8_t config_msb;
     uint8_t reg = 0;
-    if (write(file, &reg, 1) != 1) {
-        perror("Failed to set register pointer");
-        close(file);
-        return -1;
-    }
-    
     uint8_t data[2];
-    if (read(file, data, 2) != 2) {
-        perror("Failed to read from the i2c device");
-        close(file);
+    struct i2c_msg msgs[3] = {
+        {addr, I2C_M_RD, 1, &config_msb},
+        {addr, 0, 1, &reg},
+        {addr, I2C_M_RD, 2, data},
+    };
+
+    if (ADS1115_transfer(file, msgs, 3) < 0) {
+        printf("Failed to read the conversion at 0x%02x: ", addr);
+        perror("");
         return -1;
     }
-    
-    // Convert the result to 16 bits
-    int16_t value = (data[0] << 8) | data[1];
-
-    //printf("Raw value: %d\n", value);
-
-    return value;
+    if (!(config_msb & 0x80) || (config_msb & 0x70) != (((ADS1115_CONFIG_MUX_SINGLE >> 12) | (ain & 3)) << 4)) {
+        return 0;
+    }
+    *value = (data[0] << 8) | data[1];
+    return 1;
 }
 
-/*
-int main(int argc, char **argv) {
-    //init the i2c interface
-    int file = ADS1115_init(0);
-
-    if(file < 0)
-        return 1;
+int ADS1115_reset(int file){
+    // General call reset (0x00, 0x06): every ADS1115 on the bus goes back
+    // to its power-up state and releases the bus
+    uint8_t cmd = 0x06;
+    struct i2c_msg msg = {0x00, 0, 1, &cmd};
 
-
-    //Read from the module
-    int channel = 0;
-    if (argc > 1)
-        channel = atoi(argv[1]);
-
-    uint16_t value = ADS1115_read(channel,file);
-
-    // Convert to voltage (assuming -6.144V range)
-    float voltage = value * 6.144/ 32768.0;
-    
-    printf("Voltage: %.4f V\n", voltage);
-    
-    ADS1115_exit(file);
+    if (ADS1115_transfer(file, &msg, 1) < 0) {
+        perror("General call reset failed");
+        return -1;
+    }
     return 0;
-}    
-*/
-
-    
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+#ifndef ADS1115_READER_H
+#define ADS1115_READER_H
+
+#include <stdint.h>
+
+// ADS1115 default I2C address, the next chips are at +1..+3 (channels 4-7, 8-11, 12-15)
+#define DEFAULT_ADS1115_ADDRESS 0x48
+#define ADS1115_MAX_CHANNELS    16
+
+// Programmable gain: full scale of each PGA setting in mV. The chip
+// powers up at 2.048 V, the config word used to leave the bits at 0
+// (6.144 V), which stays the default
+#define ADS1115_NUM_PGA     6
+#define ADS1115_PGA_6144    0
+#define ADS1115_PGA_256     5
+extern const uint16_t ADS1115_fsr_mv[ADS1115_NUM_PGA];
+
+// Data rates in SPS, more is noisier (fewer effective bits)
+#define ADS1115_NUM_DR      8
+#define ADS1115_DR_860      7
+extern const uint16_t ADS1115_sps[ADS1115_NUM_DR];
+
+// Data rate code for a rate in SPS, -1 if the chip has no such rate
+int ADS1115_dr_code(int sps);
+
+// One single-shot conversion at a data rate, and the longest one with
+// the internal oscillator 10% slow
+static inline long ADS1115_conv_us(int dr) {
+    return 1000000L / ADS1115_sps[dr] + 1;
+}
+static inline long ADS1115_conv_max_us(int dr) {
+    return ADS1115_conv_us(dr) * 11 / 10;
+}
+
+// Opens the bus with a short adapter timeout and no retries
+int ADS1115_init(void);
+int ADS1115_exit(int file);
+
+// Non-blocking steps of a single-shot conversion on one chip
+// (ain 0-3, pga and dr codes as above), they return -1 on a bus error
+int ADS1115_start(int file, int addr, int ain, int pga, int dr);
+// 1 once the conversion started by ADS1115_start is done, 0 while busy
+int ADS1115_ready(int file, int addr);
+int ADS1115_fetch(int file, int addr, int16_t *value);
+// Fetch without a poll before it: checks the OS bit and the input of the
+// config in the same transfer. 1 with the sample, 0 when the conversion
+// is not done or the chip lost its config, -1 on a bus error
+int ADS1115_fetch_done(int file, int addr, int ain, int16_t *value);
+
+// Resets every ADS1115 on the bus, after a hang
+int ADS1115_reset(int file);
+
+#endif
@@ -0,0 +1,416 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <poll.h>
+#include <sys/stat.h>
+
+#include "ads_iio.h"
+
+#ifndef IIO_SYSFS
+#define IIO_SYSFS   "/sys/bus/iio/devices"
+#endif
+#ifndef IIO_DEV
+#define IIO_DEV     "/dev"
+#endif
+#define IIO_HRTIMER "/sys/kernel/config/iio/triggers/hrtimer"
+
+// A chip that delivers nothing for this long is stalled: the frame goes
+// on without it, and later frames take its scans only when they are there
+#define ADS_IIO_TIMEOUT_MS 100
+
+typedef struct {
+    int input;          // topology input
+    int index;          // scan index, the order in the scan
+    int offset;         // byte offset in the scan
+    int bytes;          // storage
+    int realbits;
+    int shift;
+    bool is_signed;
+    bool be;
+} IioChannel;
+
+typedef struct {
+    uint8_t addr;
+    char dir[PATH_MAX]; // IIO_SYSFS/iio:deviceN
+    int fd;
+    int num_channels;
+    IioChannel channels[TOPO_CHIP_INPUTS];
+    int scan_bytes;
+    // Scans read in bulk, handed out one per ads_iio_frame
+    uint8_t buf[ADS_IIO_BUFFER_SCANS * 16];
+    int len;
+    int pos;
+    bool stalled;       // timed out, not waited for until a scan comes
+} IioDevice;
+
+static IioDevice devices[TOPO_MAX_CHIPS];
+static int num_devices;
+static uint32_t counts[TOPO_MAX_INPUTS];
+
+static int sysfs_write(const char *dir, const char *attr, const char *fmt, ...) {
+    char path[160], val[32];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(val, sizeof(val), fmt, ap);
+    va_end(ap);
+    snprintf(path, sizeof(path), "%s/%s", dir, attr);
+
+    int fd = open(path, O_WRONLY);
+    if (fd < 0) return -1;
+    int n = write(fd, val, strlen(val));
+    close(fd);
+    return n == (int)strlen(val) ? 0 : -1;
+}
+
+static int sysfs_read(const char *dir, const char *attr, char *val, int size) {
+    char path[160];
+    snprintf(path, sizeof(path), "%s/%s", dir, attr);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    int n = read(fd, val, size - 1);
+    close(fd);
+    if (n <= 0) return -1;
+    val[n] = '\0';
+    val[strcspn(val, "\n")] = '\0';
+    return 0;
+}
+
+// iio:device or trigger directory whose name attribute is name, or whose
+// sysfs path goes through the I2C client of addr (3-0048/iio:device0)
+static int find_dir(const char *prefix, const char *name, int addr, char *dir, int size) {
+    DIR *d = opendir(IIO_SYSFS);
+    if (d == NULL) return -1;
+
+    struct dirent *e;
+    int found = -1;
+    while (found < 0 && (e = readdir(d)) != NULL) {
+        if (strncmp(e->d_name, prefix, strlen(prefix)) != 0) continue;
+        int n = snprintf(dir, size, "%s/%s", IIO_SYSFS, e->d_name);
+        if (n < 0 || n >= size) continue;
+
+        if (name != NULL) {
+            char val[64];
+            if (sysfs_read(dir, "name", val, sizeof(val)) == 0 && strcmp(val, name) == 0) found = 0;
+        } else {
+            char client[16];
+            snprintf(client, sizeof(client), "-%04x/", addr);
+            char *real = realpath(dir, NULL);
+            if (real != NULL && strstr(real, client) != NULL) found = 0;
+            free(real);
+        }
+    }
+    closedir(d);
+    return found;
+}
+
+// scan_elements/<ch>_type, e.g. le:s16/16>>0 for the ADS1115
+static int parse_type(const char *dir, const char *ch, IioChannel *c) {
+    char attr[64], val[32], endian[3], sign;
+    int storage;
+
+    snprintf(attr, sizeof(attr), "scan_elements/%s_type", ch);
+    if (sysfs_read(dir, attr, val, sizeof(val)) < 0) return -1;
+    if (sscanf(val, "%2[bl]e:%c%d/%d>>%d", endian, &sign, &c->realbits, &storage, &c->shift) != 5) return -1;
+    if (storage != 8 && storage != 16 && storage != 32) return -1;
+    if (c->realbits < 1 || c->realbits > storage) return -1;
+
+    c->be = endian[0] == 'b';
+    c->is_signed = sign == 's';
+    c->bytes = storage / 8;
+
+    snprintf(attr, sizeof(attr), "scan_elements/%s_index", ch);
+    if (sysfs_read(dir, attr, val, sizeof(val)) < 0) return -1;
+    c->index = atoi(val);
+    return 0;
+}
+
+// Scan elements of the inputs of one chip, everything else off
+static int setup_device(IioDevice *dev) {
+    // The channels can not change while the buffer runs
+    sysfs_write(dev->dir, "buffer/enable", "0");
+
+    char sd[96];
+    snprintf(sd, sizeof(sd), "%s/scan_elements", dev->dir);
+    DIR *d = opendir(sd);
+    if (d == NULL) {
+        printf("%s has no scan elements, no triggered buffer support\n", dev->dir);
+        return -1;
+    }
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        size_t n = strlen(e->d_name);
+        if (n > 3 && strcmp(e->d_name + n - 3, "_en") == 0) {
+            char attr[300];
+            snprintf(attr, sizeof(attr), "scan_elements/%s", e->d_name);
+            sysfs_write(dev->dir, attr, "0");
+        }
+    }
+    closedir(d);
+
+    for (int i = 0; i < dev->num_channels; i++) {
+        IioChannel *c = &dev->channels[i];
+        char ch[24], attr[64];
+        int ain = topology.inputs[c->input].ain;
+
+        // Single ended inputs, the differential pairs are other channels
+        snprintf(ch, sizeof(ch), "in_voltage%d", ain);
+        if (parse_type(dev->dir, ch, c) < 0) {
+            printf("%s: no usable scan element %s\n", dev->dir, ch);
+            return -1;
+        }
+        snprintf(attr, sizeof(attr), "scan_elements/%s_en", ch);
+        if (sysfs_write(dev->dir, attr, "1") < 0) {
+            printf("%s: can not enable %s\n", dev->dir, ch);
+            return -1;
+        }
+        // Gain and data rate of the topology, the ti-ads1015 has both per
+        // channel (no-op elsewhere). The scale is mV per count, auto-range
+        // is left to the i2c backend: those pads stay at +-6.144 V
+        const TopoInput *in = &topology.inputs[c->input];
+        int fsr = in->fsr_mv != TOPO_GAIN_AUTO ? in->fsr_mv : TOPO_DEFAULT_FSR_MV;
+        snprintf(attr, sizeof(attr), "%s_scale", ch);
+        sysfs_write(dev->dir, attr, "%.9f", fsr / 32768.0);
+        snprintf(attr, sizeof(attr), "%s_sampling_frequency", ch);
+        sysfs_write(dev->dir, attr, "%d", in->sps);
+    }
+
+    // Scan layout: ascending index, each value aligned to its size
+    int offset = 0;
+    int align = 1;
+    for (int done = 0; done < dev->num_channels; done++) {
+        IioChannel *next = NULL;
+        for (int i = 0; i < dev->num_channels; i++) {
+            IioChannel *c = &dev->channels[i];
+            if (c->offset < 0 && (next == NULL || c->index < next->index)) next = c;
+        }
+        offset = (offset + next->bytes - 1) / next->bytes * next->bytes;
+        next->offset = offset;
+        offset += next->bytes;
+        if (next->bytes > align) align = next->bytes;
+    }
+    dev->scan_bytes = (offset + align - 1) / align * align;
+    return 0;
+}
+
+static int setup_trigger(const char *trigger, int rate_hz) {
+    static char dir[PATH_MAX];     // off the stack, over -Wstack-usage
+    char path[128];
+
+    // An hrtimer trigger unless one with that name exists (sysfs, data ready)
+    if (find_dir("trigger", trigger, 0, dir, sizeof(dir)) < 0) {
+        snprintf(path, sizeof(path), "%s/%s", IIO_HRTIMER, trigger);
+        if (mkdir(path, 0755) < 0 && errno != EEXIST) {
+            printf("Creating the hrtimer trigger %s: %s (configfs mounted, iio-trig-hrtimer loaded?)\n", path, strerror(errno));
+            return -1;
+        }
+        if (find_dir("trigger", trigger, 0, dir, sizeof(dir)) < 0) {
+            printf("Trigger %s did not show up in %s\n", trigger, IIO_SYSFS);
+            return -1;
+        }
+    }
+    if (sysfs_write(dir, "sampling_frequency", "%d", rate_hz) < 0) {
+        printf("Trigger %s has no settable rate, using it as it is\n", trigger);
+    }
+    return 0;
+}
+
+int ads_iio_init(const char *dev_name, const char *trigger, int rate_hz) {
+    num_devices = 0;
+    for (int i = 0; i < topology.num_inputs; i++) {
+        const TopoInput *in = &topology.inputs[i];
+        int d = 0;
+        while (d < num_devices && devices[d].addr != in->addr) d++;
+        if (d == num_devices) {
+            devices[d].addr = in->addr;
+            devices[d].num_channels = 0;
+            devices[d].fd = -1;
+            devices[d].len = 0;
+            devices[d].pos = 0;
+            devices[d].stalled = false;
+            num_devices++;
+        }
+        IioChannel *c = &devices[d].channels[devices[d].num_channels++];
+        c->input = i;
+        c->offset = -1;
+        counts[i] = 0;
+    }
+
+    if (setup_trigger(trigger, rate_hz) < 0) return -1;
+
+    for (int d = 0; d < num_devices; d++) {
+        IioDevice *dev = &devices[d];
+        const char *name = d == 0 ? dev_name : NULL;
+
+        if (find_dir("iio:device", name, dev->addr, dev->dir, sizeof(dev->dir)) < 0) {
+            if (name != NULL) printf("No IIO device named %s\n", name);
+            else printf("No IIO device for the ADS1115 at 0x%02x (ti-ads1015 bound?)\n", dev->addr);
+            return -1;
+        }
+        if (setup_device(dev) < 0) return -1;
+
+        char node[64];
+        snprintf(node, sizeof(node), IIO_DEV "/%s", strrchr(dev->dir, '/') + 1);
+        dev->fd = open(node, O_RDONLY | O_NONBLOCK);
+        if (dev->fd < 0) {
+            perror(node);
+            return -1;
+        }
+
+        if (sysfs_write(dev->dir, "trigger/current_trigger", "%s", trigger) < 0) {
+            printf("%s: can not attach trigger %s\n", dev->dir, trigger);
+            return -1;
+        }
+        sysfs_write(dev->dir, "buffer/length", "%d", ADS_IIO_BUFFER_SCANS);
+        // Wake up on every scan, a hit must not wait for a batch to fill
+        sysfs_write(dev->dir, "buffer/watermark", "1");
+        if (sysfs_write(dev->dir, "buffer/enable", "1") < 0) {
+            printf("%s: can not enable the buffer: %s\n", dev->dir, strerror(errno));
+            return -1;
+        }
+        printf("ADS1115 0x%02x: %s, %d inputs, %d bytes per scan\n", dev->addr, dev->dir,
+               dev->num_channels, dev->scan_bytes);
+    }
+    return 0;
+}
+
+static int16_t channel_value(const IioChannel *c, const uint8_t *scan) {
+    const uint8_t *p = scan + c->offset;
+    uint32_t raw = 0;
+    for (int i = 0; i < c->bytes; i++) {
+        raw = c->be ? raw << 8 | p[i] : raw | (uint32_t)p[i] << (8 * i);
+    }
+    raw >>= c->shift;
+
+    int bits = c->realbits;
+    raw &= bits >= 32 ? 0xffffffffu : (1u << bits) - 1;
+    int32_t v = (int32_t)raw;
+    if (c->is_signed && bits < 32 && (raw & (1u << (bits - 1)))) {
+        v -= (int32_t)(1u << bits);
+    }
+
+    // Same counts as the ADS1115 read over i2c-dev: full scale is 16 bits
+    if (c->is_signed) bits--;
+    if (bits < 15) v <<= 15 - bits;
+    else if (bits > 15) v >>= bits - 15;
+    return (int16_t)v;
+}
+
+// Refills the scans of a device with everything the kernel has, in one
+// read, once the ones read before are used up. -1 on a read error
+static int refill(IioDevice *dev) {
+    if (dev->len - dev->pos >= dev->scan_bytes) return 0;
+
+    int room = sizeof(dev->buf) / dev->scan_bytes * dev->scan_bytes;
+    int n = read(dev->fd, dev->buf, room);
+    if (n < 0 && errno != EAGAIN) {
+        perror(dev->dir);
+        return -1;
+    }
+    dev->pos = 0;
+    dev->len = n > 0 ? n : 0;
+    return 0;
+}
+
+// Stalled chips only count when the others are stalled too
+static bool skip_stalled(void) {
+    for (int d = 0; d < num_devices; d++) {
+        if (!devices[d].stalled) return true;
+    }
+    return false;
+}
+
+bool ads_iio_queued(void) {
+    bool skip = skip_stalled();
+    bool queued = false;
+    for (int d = 0; d < num_devices; d++) {
+        IioDevice *dev = &devices[d];
+        if (refill(dev) < 0) return false;
+        bool buffered = dev->len - dev->pos >= dev->scan_bytes;
+        if (!buffered && !(skip && dev->stalled)) return false;
+        queued |= buffered;
+    }
+    return queued;
+}
+
+int ads_iio_frame(int16_t values[TOPO_MAX_INPUTS]) {
+    uint32_t fresh = 0;
+    bool pending[TOPO_MAX_CHIPS];
+    int waiting = num_devices;
+    bool skip = skip_stalled();
+
+    for (int d = 0; d < num_devices; d++) pending[d] = true;
+
+    while (waiting > 0) {
+        struct pollfd fds[TOPO_MAX_CHIPS];
+        int nfds = 0;
+
+        for (int d = 0; d < num_devices; d++) {
+            IioDevice *dev = &devices[d];
+            if (!pending[d]) continue;
+
+            if (refill(dev) < 0) return -1;
+            if (dev->len - dev->pos < dev->scan_bytes) {
+                if (skip && dev->stalled) {
+                    pending[d] = false;
+                    waiting--;
+                    continue;
+                }
+                fds[nfds].fd = dev->fd;
+                fds[nfds].events = POLLIN;
+                nfds++;
+                continue;
+            }
+            if (dev->stalled) {
+                printf("%s delivers scans again\n", dev->dir);
+                dev->stalled = false;
+            }
+
+            const uint8_t *scan = dev->buf + dev->pos;
+            dev->pos += dev->scan_bytes;
+            for (int i = 0; i < dev->num_channels; i++) {
+                const IioChannel *c = &dev->channels[i];
+                values[c->input] = channel_value(c, scan);
+                fresh |= 1u << c->input;
+                counts[c->input]++;
+            }
+            pending[d] = false;
+            waiting--;
+        }
+
+        if (nfds > 0 && poll(fds, nfds, ADS_IIO_TIMEOUT_MS) <= 0) {
+            // The scans taken from the other chips still count
+            for (int d = 0; d < num_devices; d++) {
+                if (!pending[d] || devices[d].stalled) continue;
+                printf("%s delivered nothing for %d ms, not waited for until it does\n", devices[d].dir,
+                       ADS_IIO_TIMEOUT_MS);
+                devices[d].stalled = true;
+            }
+            return fresh;
+        }
+    }
+    return fresh;
+}
+
+void ads_iio_take_counts(uint32_t out[TOPO_MAX_INPUTS]) {
+    for (int i = 0; i < TOPO_MAX_INPUTS; i++) {
+        out[i] = counts[i];
+        counts[i] = 0;
+    }
+}
+
+void ads_iio_exit(void) {
+    for (int d = 0; d < num_devices; d++) {
+        sysfs_write(devices[d].dir, "buffer/enable", "0");
+        if (devices[d].fd >= 0) close(devices[d].fd);
+        devices[d].fd = -1;
+    }
+    num_devices = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef ADS_IIO_H
+#define ADS_IIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "topology.h"
+
+// Scan rate of the hrtimer trigger. Each scan converts the inputs of a
+// chip one after the other in the driver, 3 inputs at 860 SPS leave ~280
+#define ADS_IIO_DEFAULT_RATE_HZ 250
+#define ADS_IIO_DEFAULT_TRIGGER "drumkit"
+
+// Kernel buffer per device, in scans
+#define ADS_IIO_BUFFER_SCANS    128
+
+// Same job as the ads_scheduler, done by the in-kernel ti-ads1015 driver:
+// every chip of the topology is an iio:device (found by its I2C address),
+// the used inputs are enabled as scan elements and one hrtimer trigger
+// (created through configfs if missing) drives the triggered buffers.
+// dev_name picks a device by name for the first chip instead, e.g. an
+// iio_dummy instance for testing. Returns -1 if any step fails
+int ads_iio_init(const char *dev_name, const char *trigger, int rate_hz);
+
+// Next scan of every chip, the reads take whatever the kernel buffered.
+// Same contract as ads_scheduler_frame: mask of inputs updated in values,
+// -1 on a read error. A chip that delivered nothing within the timeout is
+// left out of the mask and not waited for again until it delivers, the
+// other chips keep their pace
+int ads_iio_frame(int16_t values[TOPO_MAX_INPUTS]);
+
+// true while every chip but the stalled ones has another scan buffered,
+// and at least one has: the next ads_iio_frame
+// returns it without waiting. The main loop runs each of them through
+// the trigger detection before it goes back to the UI, a hit is never
+// left queued behind a display refresh
+bool ads_iio_queued(void);
+
+// Scans delivered since the last call, per input
+void ads_iio_take_counts(uint32_t counts[TOPO_MAX_INPUTS]);
+
+// Stops the buffers so the channels can be reconfigured
+void ads_iio_exit(void);
+
+#endif
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ads_replay.h"
+#include "capture.h"
+
+typedef struct {
+    uint64_t t_ns;
+    int16_t peak;
+} ReplayHit;
+
+typedef struct {
+    // Pending hits, a ring in time order
+    ReplayHit queue[ADS_REPLAY_MAX_HITS];
+    unsigned head, tail;
+    // The hit ringing now
+    bool ringing;
+    ReplayHit current;
+    uint32_t count;
+} ReplayInput;
+
+static ReplayInput inputs[TOPO_MAX_INPUTS];
+
+// Frames of the capture file, NULL for the synthetic source
+static int16_t (*frames)[TOPO_MAX_INPUTS];
+static uint64_t *frame_ns;
+static uint32_t *frame_fresh;
+static unsigned num_frames;
+static unsigned next_frame;
+
+static uint64_t next_ns;        // time of the next frame
+static uint64_t loop_start_ns;  // capture: time frame 0 of this loop plays at
+static uint32_t noise_state = 1;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void sleep_until(uint64_t t_ns) {
+    struct timespec ts = {t_ns / 1000000000ull, t_ns % 1000000000ull};
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+    }
+}
+
+static int16_t clip16(int32_t v) {
+    return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v;
+}
+
+// The frames still in the ring, oldest first, at the gains of the topology
+static int load_capture(const char *path) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(path);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+
+    const CapHeader *h = map;
+    if ((size_t)st.st_size < sizeof(CapHeader) || memcmp(h->magic, CAP_MAGIC, sizeof(CAP_MAGIC)) != 0 ||
+        h->version != CAP_VERSION || (size_t)st.st_size < h->data_offset + (size_t)h->capacity * h->frame_size) {
+        printf("%s is not a version %d capture ring\n", path, CAP_VERSION);
+        munmap(map, st.st_size);
+        return -1;
+    }
+    if ((int)h->num_inputs != topology.num_inputs) {
+        printf("%s has %u inputs, the topology %d\n", path, h->num_inputs, topology.num_inputs);
+        munmap(map, st.st_size);
+        return -1;
+    }
+
+    unsigned end = atomic_load(&h->frames);
+    num_frames = end < h->capacity ? end : h->capacity - 1;
+    if (num_frames == 0) {
+        printf("%s holds no frames\n", path);
+        munmap(map, st.st_size);
+        return -1;
+    }
+    frames = malloc(num_frames * sizeof(frames[0]));
+    frame_ns = malloc(num_frames * sizeof(frame_ns[0]));
+    frame_fresh = malloc(num_frames * sizeof(frame_fresh[0]));
+
+    const uint8_t *ring = (const uint8_t *)map + h->data_offset;
+    for (unsigned i = 0; i < num_frames; i++) {
+        unsigned n = (end - num_frames + i) & (h->capacity - 1);
+        const CapFrame *f = (const CapFrame *)(ring + (size_t)n * h->frame_size);
+        frame_ns[i] = f->t_ns;
+        frame_fresh[i] = f->fresh;
+        for (int in = 0; in < topology.num_inputs; in++) {
+            int32_t fsr = topology.inputs[in].fsr_mv ? topology.inputs[in].fsr_mv : TOPO_DEFAULT_FSR_MV;
+            frames[i][in] = clip16((int32_t)f->data[in] * (uint16_t)f->data[h->num_inputs + in] / fsr);
+        }
+    }
+    munmap(map, st.st_size);
+    printf("Replaying %u ADC frames (%.1f s) from %s\n", num_frames,
+           (frame_ns[num_frames - 1] - frame_ns[0]) / 1e9, path);
+    return 0;
+}
+
+int ads_replay_init(const char *path) {
+    memset(inputs, 0, sizeof(inputs));
+    if (path != NULL && load_capture(path) < 0) {
+        return -1;
+    }
+    if (path == NULL) {
+        printf("Synthetic ADC frames at %d Hz\n", ADS_REPLAY_RATE_HZ);
+    }
+    next_frame = 0;
+    next_ns = loop_start_ns = now_ns();
+    return 0;
+}
+
+void ads_replay_hit(int input, uint64_t t_ns, int16_t peak) {
+    ReplayInput *in = &inputs[input];
+    if (in->head - in->tail == ADS_REPLAY_MAX_HITS) {
+        return;
+    }
+    in->queue[in->head % ADS_REPLAY_MAX_HITS] = (ReplayHit){t_ns, peak};
+    in->head++;
+}
+
+// Synthetic ring of the input at t_ns, 0 once it died out
+static int32_t hit_value(ReplayInput *in, uint64_t t_ns) {
+    while (in->tail != in->head && in->queue[in->tail % ADS_REPLAY_MAX_HITS].t_ns <= t_ns) {
+        in->current = in->queue[in->tail % ADS_REPLAY_MAX_HITS];
+        in->ringing = true;
+        in->tail++;
+    }
+    if (!in->ringing) {
+        return 0;
+    }
+    float dt = (t_ns - in->current.t_ns) / 1e9f;
+    if (dt > 6 * ADS_REPLAY_DECAY_MS / 1000.0f) {
+        in->ringing = false;
+        return 0;
+    }
+    return (int32_t)(in->current.peak * expf(-dt * 1000.0f / ADS_REPLAY_DECAY_MS) *
+                     cosf(2.0f * (float)M_PI * ADS_REPLAY_RING_HZ * dt));
+}
+
+static int32_t noise(void) {
+    noise_state = noise_state * 1664525u + 1013904223u;
+    return (int32_t)(noise_state >> 16) % (2 * ADS_REPLAY_NOISE + 1) - ADS_REPLAY_NOISE;
+}
+
+int ads_replay_frame(int16_t values[TOPO_MAX_INPUTS]) {
+    uint32_t fresh;
+
+    if (frames != NULL) {
+        if (next_frame == num_frames) {
+            // Next loop one frame gap after the last frame
+            loop_start_ns = next_ns + 1000000000ull / ADS_REPLAY_RATE_HZ;
+            next_frame = 0;
+        }
+        next_ns = loop_start_ns + (frame_ns[next_frame] - frame_ns[0]);
+    } else {
+        next_ns += 1000000000ull / ADS_REPLAY_RATE_HZ;
+    }
+    // Far behind (stopped in a debugger): start over from now
+    uint64_t now = now_ns();
+    if (now > next_ns + 100000000ull) {
+        loop_start_ns += now - next_ns;
+        next_ns = now;
+    }
+    sleep_until(next_ns);
+
+    if (frames != NULL) {
+        fresh = frame_fresh[next_frame];
+        memcpy(values, frames[next_frame], topology.num_inputs * sizeof(int16_t));
+        next_frame++;
+    } else {
+        fresh = (1u << topology.num_inputs) - 1;
+        for (int i = 0; i < topology.num_inputs; i++) {
+            values[i] = i == topology.pot_input ? INT16_MAX / 2 : noise();
+        }
+    }
+
+    for (int i = 0; i < topology.num_inputs; i++) {
+        ReplayInput *in = &inputs[i];
+        if (in->ringing || in->tail != in->head) {
+            int32_t v = hit_value(in, next_ns);
+            if (v != 0) {
+                values[i] = clip16(values[i] + v);
+                fresh |= 1u << i;
+            }
+        }
+        if (fresh & (1u << i)) in->count++;
+    }
+    return fresh;
+}
+
+void ads_replay_take_counts(uint32_t counts[TOPO_MAX_INPUTS]) {
+    for (int i = 0; i < topology.num_inputs; i++) {
+        counts[i] = inputs[i].count;
+        inputs[i].count = 0;
+    }
+}
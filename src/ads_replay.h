@@ -0,0 +1,38 @@
+#ifndef ADS_REPLAY_H
+#define ADS_REPLAY_H
+
+#include <stdint.h>
+
+#include "topology.h"
+
+// Frame rate of the synthetic source, a fast board
+#define ADS_REPLAY_RATE_HZ      1000
+
+// Synthetic piezo: noise at rest, a hit is a decaying ring at full
+// amplitude from its first sample (the fastest possible attack)
+#define ADS_REPLAY_NOISE        16
+#define ADS_REPLAY_RING_HZ      180
+#define ADS_REPLAY_DECAY_MS     8
+
+// Hits ads_replay_hit holds per input until their time comes
+#define ADS_REPLAY_MAX_HITS     16
+
+// ADC backend without the board, for the latency harness and for running
+// the app on a desk. The frames come from a DRUM_CAPTURE ring file
+// (capture.h), played at their recorded times in a loop and converted to
+// the gain of the topology, or with path NULL from the synthetic source.
+// Returns -1 if the file can not be read
+int ads_replay_init(const char *path);
+
+// Adds a synthetic hit of peak counts on top of the input from t_ns
+// (CLOCK_MONOTONIC) on. Hits of an input are given in time order
+void ads_replay_hit(int input, uint64_t t_ns, int16_t peak);
+
+// Waits for the next frame time. Same contract as ads_scheduler_frame:
+// mask of the inputs updated in values
+int ads_replay_frame(int16_t values[TOPO_MAX_INPUTS]);
+
+// Samples delivered since the last call, per input
+void ads_replay_take_counts(uint32_t counts[TOPO_MAX_INPUTS]);
+
+#endif
@@ -0,0 +1,422 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ads1115_reader.h"
+#include "ads_scheduler.h"
+
+// Poll again this long after a conversion was not done yet (the chip
+// oscillator is +-10%)
+#define ADS_REPOLL_US 50
+
+// Stride scheduling among the pads of a chip: the pad with the lowest
+// pass goes next and advances it by ADS_STRIDE (ADS_STRIDE / ADS_BOOST
+// while boosted), so each pad gets a share of conversions proportional
+// to its weight
+#define ADS_STRIDE    12
+
+// Consecutive errors before a chip is taken offline, it is then retried
+// every ADS_RETRY_MS, doubling up to 8x while it keeps failing
+#define ADS_OFFLINE_AFTER   3
+#define ADS_RETRY_MS        100
+
+// Longest sleep of a frame while every chip is offline
+#define ADS_OFFLINE_WAIT_MS 10
+
+typedef struct {
+    uint8_t chip;
+    uint8_t ain;
+    uint16_t rate_hz;           // 0 = as fast as the chip allows
+    uint8_t pga;                // gain of the next conversion
+    uint8_t dr;
+    uint8_t sample_pga;         // gain of the last sample handed out
+    bool auto_range;
+    bool in_hit;
+    uint8_t hits;               // since the last step up
+    int16_t peak;               // loudest of those hits
+    struct timespec next_due;   // rate limited inputs only
+    struct timespec boost_until;
+    uint32_t pass;
+    uint32_t count;
+} AdsInput;
+
+// Built from the topology by ads_scheduler_init
+static AdsInput inputs[ADS_MAX_INPUTS];
+static int num_inputs;
+
+typedef struct {
+    int addr;
+    int input;              // input being converted
+    uint8_t pga;            // and its gain
+    bool busy;
+    bool offline;
+    uint8_t failures;       // consecutive
+    uint32_t inputs;        // mask of its inputs
+    struct timespec started;
+    struct timespec due;    // when the conversion should be done, or when
+                            // to start the next rate limited input if idle
+} AdsChip;
+
+static AdsChip chips[ADS_MAX_CHIPS];
+static int num_chips;
+static int ads_file = -1;
+static uint32_t fast_mask;
+static uint32_t offline_inputs;
+static AdsErrors errors;
+static uint32_t rescaled;
+
+// A sample that would have overwritten one of the current frame, it
+// opens the next frame instead
+static int pending_input = -1;
+static int16_t pending_value;
+static uint8_t pending_pga;
+
+static void add_us(struct timespec *ts, long us) {
+    ts->tv_nsec += us * 1000;
+    while (ts->tv_nsec >= 1000000000) {
+        ts->tv_nsec -= 1000000000;
+        ts->tv_sec++;
+    }
+}
+
+static bool before(const struct timespec *a, const struct timespec *b) {
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+// Next input for a chip, -1 when it only has rate limited inputs and none is due
+static int next_input(int chip, const struct timespec *now) {
+    int pick = -1;
+
+    for (int i = 0; i < num_inputs; i++) {
+        AdsInput *in = &inputs[i];
+        if (in->chip != chip || in->rate_hz == 0 || before(now, &in->next_due)) continue;
+        if (pick < 0 || before(&in->next_due, &inputs[pick].next_due)) pick = i;
+    }
+    if (pick >= 0) {
+        AdsInput *in = &inputs[pick];
+        add_us(&in->next_due, 1000000 / in->rate_hz);
+        // Too far behind (bus errors, a long frame), do not catch up with a burst
+        if (before(&in->next_due, now)) {
+            in->next_due = *now;
+            add_us(&in->next_due, 1000000 / in->rate_hz);
+        }
+        return pick;
+    }
+
+    for (int i = 0; i < num_inputs; i++) {
+        AdsInput *in = &inputs[i];
+        if (in->chip != chip || in->rate_hz != 0) continue;
+        if (pick < 0 || (int32_t)(in->pass - inputs[pick].pass) < 0) pick = i;
+    }
+    if (pick >= 0) {
+        AdsInput *in = &inputs[pick];
+        in->pass += before(now, &in->boost_until) ? ADS_STRIDE / ADS_BOOST : ADS_STRIDE;
+    }
+    return pick;
+}
+
+// Bus re-opened and every chip reset, when none answers anymore
+static void bus_recover(void) {
+    errors.recoveries++;
+    printf("I2C: no ADS1115 answers, re-opening the bus and resetting the chips\n");
+
+    int file = ADS1115_init();
+    if (file >= 0) {
+        close(ads_file);
+        ads_file = file;
+    }
+    ADS1115_reset(ads_file);
+}
+
+// A failed transfer or conversion: the chip is retried right away a few
+// times, then left out of the frames until it answers again
+static void chip_error(AdsChip *chip, bool timeout) {
+    if (timeout) errors.timeouts++;
+    else errors.bus_errors++;
+
+    chip->busy = false;
+    clock_gettime(CLOCK_MONOTONIC, &chip->due);
+    if (chip->failures < UINT8_MAX) chip->failures++;
+    if (chip->failures < ADS_OFFLINE_AFTER) return;
+
+    if (!chip->offline) {
+        printf("ADS1115 0x%02x offline, its pads are skipped\n", chip->addr);
+        chip->offline = true;
+        offline_inputs |= chip->inputs;
+    }
+    int backoff = chip->failures - ADS_OFFLINE_AFTER;
+    if (backoff > 3) backoff = 3;
+    add_us(&chip->due, (ADS_RETRY_MS * 1000L) << backoff);
+
+    for (int c = 0; c < num_chips; c++) {
+        if (!chips[c].offline) return;
+    }
+    bus_recover();
+}
+
+static void chip_ok(AdsChip *chip) {
+    chip->failures = 0;
+    if (chip->offline) {
+        printf("ADS1115 0x%02x back online\n", chip->addr);
+        chip->offline = false;
+        offline_inputs &= ~chip->inputs;
+    }
+}
+
+static int start_next(AdsChip *chip) {
+    int c = chip - chips;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    int input = next_input(c, &now);
+    if (input < 0) {
+        // Idle until the first rate limited input is due
+        chip->busy = false;
+        chip->due.tv_sec = now.tv_sec + 1;
+        chip->due.tv_nsec = now.tv_nsec;
+        for (int i = 0; i < num_inputs; i++) {
+            if (inputs[i].chip == c && inputs[i].rate_hz != 0 && before(&inputs[i].next_due, &chip->due)) {
+                chip->due = inputs[i].next_due;
+            }
+        }
+        return 0;
+    }
+
+    AdsInput *in = &inputs[input];
+    if (ADS1115_start(ads_file, chip->addr, in->ain, in->pga, in->dr) < 0) {
+        return -1;
+    }
+    chip->input = input;
+    chip->pga = in->pga;
+    chip->busy = true;
+    clock_gettime(CLOCK_MONOTONIC, &chip->started);
+    chip->due = chip->started;
+    add_us(&chip->due, ADS1115_conv_us(in->dr));
+    return 0;
+}
+
+// Gain of an auto-ranged pad from a sample taken at pga. Only samples
+// at its current gain count, the ones still converting at the old gain
+// when it changed do not
+static void auto_range(AdsInput *in, int16_t value, int pga, const struct timespec *now) {
+    if (pga != in->pga) return;
+
+    int level = abs(value);
+    if (level >= ADS_RANGE_CLIP) {
+        if (in->pga > ADS1115_PGA_6144) in->pga--;
+        in->hits = 0;
+        in->peak = 0;
+        in->in_hit = false;
+        return;
+    }
+
+    // A hit lasts as long as the pad is boosted
+    if (before(now, &in->boost_until)) {
+        if (level > in->peak) in->peak = level;
+        in->in_hit = true;
+        return;
+    }
+    if (!in->in_hit) return;
+    in->in_hit = false;
+    if (++in->hits < ADS_RANGE_HITS) return;
+
+    if (in->pga < ADS1115_PGA_256 &&
+        (int32_t)in->peak * ADS1115_fsr_mv[in->pga] / ADS1115_fsr_mv[in->pga + 1] < ADS_RANGE_HEADROOM) {
+        in->pga++;
+    }
+    in->hits = 0;
+    in->peak = 0;
+}
+
+// A sample into the frame, flagged when it is the first at a new gain
+static void deliver(int16_t values[ADS_MAX_INPUTS], int input, int16_t value, int pga) {
+    values[input] = value;
+    if (pga != inputs[input].sample_pga) {
+        inputs[input].sample_pga = pga;
+        rescaled |= 1u << input;
+    }
+}
+
+void ads_scheduler_init(int file) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    ads_file = file;
+    fast_mask = 0;
+    offline_inputs = 0;
+    rescaled = 0;
+    memset(&errors, 0, sizeof(errors));
+    num_chips = 0;
+    num_inputs = topology.num_inputs;
+    for (int i = 0; i < num_inputs; i++) {
+        const TopoInput *topo = &topology.inputs[i];
+        int c = 0;
+        while (c < num_chips && chips[c].addr != topo->addr) c++;
+        if (c == num_chips) {
+            chips[c].addr = topo->addr;
+            chips[c].input = -1;
+            chips[c].busy = false;
+            chips[c].offline = false;
+            chips[c].failures = 0;
+            chips[c].inputs = 0;
+            chips[c].due = now;
+            num_chips++;
+        }
+        chips[c].inputs |= 1u << i;
+
+        inputs[i].chip = c;
+        inputs[i].ain = topo->ain;
+        inputs[i].rate_hz = topo->channel == TOPO_POT ? ADS_POT_RATE_HZ : 0;
+        inputs[i].auto_range = topo->fsr_mv == TOPO_GAIN_AUTO;
+        inputs[i].pga = ADS1115_PGA_6144;
+        for (int pga = 0; pga < ADS1115_NUM_PGA; pga++) {
+            if (ADS1115_fsr_mv[pga] == topo->fsr_mv) inputs[i].pga = pga;
+        }
+        inputs[i].sample_pga = inputs[i].pga;
+        inputs[i].dr = ADS1115_dr_code(topo->sps);
+        inputs[i].in_hit = false;
+        inputs[i].hits = 0;
+        inputs[i].peak = 0;
+        inputs[i].next_due = now;
+        inputs[i].boost_until = now;
+        inputs[i].pass = 0;
+        inputs[i].count = 0;
+        if (inputs[i].rate_hz == 0) fast_mask |= 1u << i;
+    }
+}
+
+int ads_scheduler_frame(int16_t values[ADS_MAX_INPUTS]) {
+    uint32_t fresh = 0;
+    bool tried = false;
+
+    if (pending_input >= 0) {
+        deliver(values, pending_input, pending_value, pending_pga);
+        fresh |= 1u << pending_input;
+        pending_input = -1;
+    }
+
+    for (;;) {
+        // The pads of offline chips are not waited for
+        uint32_t wanted = fast_mask & ~offline_inputs;
+        if (wanted != 0 ? (fresh & wanted) == wanted : tried) break;
+
+        // Serve the chip that is due first, the others keep converting
+        AdsChip *chip = &chips[0];
+        for (int c = 1; c < num_chips; c++) {
+            if (before(&chips[c].due, &chip->due)) chip = &chips[c];
+        }
+
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (wanted == 0) {
+            // Nothing but retries: do not hold the main loop until the next one
+            struct timespec limit = now;
+            add_us(&limit, ADS_OFFLINE_WAIT_MS * 1000);
+            if (before(&limit, &chip->due)) {
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &limit, NULL);
+                break;
+            }
+        }
+        if (before(&now, &chip->due)) {
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &chip->due, NULL);
+        }
+        tried = true;
+
+        if (!chip->busy) {
+            if (start_next(chip) < 0) chip_error(chip, false);
+            continue;
+        }
+
+        // With several chips the bus, not the conversions, is the limit:
+        // past the slowest possible conversion the separate OS bit poll is
+        // skipped, the fetch checks it. Not done by then is a timeout
+        int16_t value;
+        int input = chip->input;
+        int pga = chip->pga;
+        int ok;
+        struct timespec done = chip->started;
+        add_us(&done, ADS1115_conv_max_us(inputs[input].dr));
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (before(&now, &done)) {
+            ok = ADS1115_ready(ads_file, chip->addr);
+            if (ok == 0) {
+                // Poll again, at the latest when the fetch can go without a poll
+                clock_gettime(CLOCK_MONOTONIC, &chip->due);
+                add_us(&chip->due, ADS_REPOLL_US);
+                if (before(&done, &chip->due)) chip->due = done;
+                continue;
+            }
+            if (ok > 0) ok = ADS1115_fetch(ads_file, chip->addr, &value) < 0 ? -1 : 1;
+        } else {
+            ok = ADS1115_fetch_done(ads_file, chip->addr, inputs[input].ain, &value);
+        }
+        if (ok <= 0) {
+            chip_error(chip, ok == 0);
+            continue;
+        }
+        chip_ok(chip);
+        inputs[input].count++;
+        if (inputs[input].auto_range) auto_range(&inputs[input], value, pga, &now);
+
+        // Straight into the next input so the chip never sits idle, the
+        // sample just read is good either way
+        if (start_next(chip) < 0) chip_error(chip, false);
+
+        if (fresh & (1u << input)) {
+            pending_input = input;
+            pending_value = value;
+            pending_pga = pga;
+            break;
+        }
+        deliver(values, input, value, pga);
+        fresh |= 1u << input;
+    }
+    return fresh;
+}
+
+void ads_scheduler_boost(int input) {
+    if (input < 0 || input >= num_inputs || inputs[input].rate_hz != 0) return;
+
+    AdsInput *in = &inputs[input];
+    clock_gettime(CLOCK_MONOTONIC, &in->boost_until);
+    add_us(&in->boost_until, ADS_BOOST_MS * 1000);
+
+    // Start from the lowest pass of the chip, no burst to pay back an old
+    // lead and no wait behind the others
+    for (int i = 0; i < num_inputs; i++) {
+        if (i != input && inputs[i].chip == in->chip && inputs[i].rate_hz == 0 &&
+            (int32_t)(inputs[i].pass - in->pass) < 0) {
+            in->pass = inputs[i].pass;
+        }
+    }
+}
+
+void ads_scheduler_take_counts(uint32_t counts[ADS_MAX_INPUTS]) {
+    for (int i = 0; i < num_inputs; i++) {
+        counts[i] = inputs[i].count;
+        inputs[i].count = 0;
+    }
+}
+
+uint32_t ads_scheduler_offline(void) {
+    return offline_inputs;
+}
+
+void ads_scheduler_take_errors(AdsErrors *out) {
+    *out = errors;
+    out->offline = offline_inputs;
+    memset(&errors, 0, sizeof(errors));
+}
+
+float ads_scheduler_scale(int input) {
+    return (float)ADS1115_fsr_mv[ADS1115_PGA_6144] / ADS1115_fsr_mv[inputs[input].sample_pga];
+}
+
+uint32_t ads_scheduler_take_rescaled(void) {
+    uint32_t mask = rescaled;
+    rescaled = 0;
+    return mask;
+}
@@ -0,0 +1,70 @@
+#ifndef ADS_SCHEDULER_H
+#define ADS_SCHEDULER_H
+
+#include <stdint.h>
+
+#include "topology.h"
+
+// Chips and inputs come from the topology, up to 4 chips and 16 inputs
+#define ADS_MAX_CHIPS   TOPO_MAX_CHIPS
+#define ADS_MAX_INPUTS  TOPO_MAX_INPUTS
+
+// The volume pot (topology.pot_input) only needs a human rate
+#define ADS_POT_RATE_HZ 20
+
+// A pad that was hit gets BOOST times its share of its chip for BOOST_MS
+#define ADS_BOOST       3
+#define ADS_BOOST_MS    50
+
+// Auto-ranged pads (gain=auto in the topology): a sample this close to
+// full scale takes the gain one step down right away. Every ADS_RANGE_HITS
+// hits the gain goes one step up if the loudest of them would still stay
+// under ADS_RANGE_HEADROOM at the higher gain
+#define ADS_RANGE_CLIP      32000
+#define ADS_RANGE_HITS      8
+#define ADS_RANGE_HEADROOM  16384
+
+// Keeps every ADS1115 of the topology converting all the time: while
+// one chip converts the others are read and started on their next input,
+// so a conversion is only waited for when all chips are busy.
+// Each input has a target rate: pads run as fast as the chip allows
+// (sharing it by weight, see ads_scheduler_boost), the pot at
+// ADS_POT_RATE_HZ in between.
+void ads_scheduler_init(int file);
+
+typedef struct {
+    uint32_t bus_errors;    // failed transfers
+    uint32_t timeouts;      // conversions that never finished
+    uint32_t recoveries;    // bus re-opened and chips reset
+    uint32_t offline;       // inputs of the chips currently left out
+} AdsErrors;
+
+// Returns once every pad has a new sample in values (indexed like
+// topology.inputs), or earlier when a boosted pad is about to get a
+// second one. The result is the mask of inputs updated in values, only
+// real samples: a chip that fails is retried, then taken offline and its
+// pads are left out of the mask (and not waited for) until it answers
+// again. The next conversions are already running when it returns
+int ads_scheduler_frame(int16_t values[ADS_MAX_INPUTS]);
+
+// Inputs of the chips currently offline
+uint32_t ads_scheduler_offline(void);
+
+// Errors since the last call, offline is the current mask
+void ads_scheduler_take_errors(AdsErrors *errors);
+
+// Samples the pad more often for ADS_BOOST_MS, to follow the ring-out of a hit
+void ads_scheduler_boost(int input);
+
+// Conversions completed since the last call, per input
+void ads_scheduler_take_counts(uint32_t counts[ADS_MAX_INPUTS]);
+
+// Counts of the last sample of an input per count at +-6.144 V (1 to 24),
+// the gain of the topology until an auto-ranged pad moves it
+float ads_scheduler_scale(int input);
+
+// Inputs whose gain changed since the last call: their sample in the last
+// frame is the first one at the new ads_scheduler_scale
+uint32_t ads_scheduler_take_rescaled(void);
+
+#endif
@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "calibration.h"
+
+// Running estimate: offset and noise are exponential moving averages with
+// weight 1/CAL_TRACK_WINDOW, starting as plain averages so an uncalibrated
+// pad settles in its first few hundred frames
+#define CAL_TRACK_WINDOW  512
+// Uncalibrated pads keep the default threshold until this many samples were tracked
+#define CAL_TRACK_WARMUP  1024
+// Frames skipped after a hit so the ring-out does not count as noise
+#define CAL_HOLDOFF       64
+
+PadCalibration pad_calibration[CAL_NUM_INPUTS];
+
+static uint32_t tracked[CAL_NUM_INPUTS];
+static uint16_t holdoff[CAL_NUM_INPUTS];
+static float cal_scale[CAL_NUM_INPUTS];
+
+static char cal_path[256] = CAL_DEFAULT_FILE;
+static bool cal_running = false;
+static int16_t cal_samples[CAL_NUM_INPUTS][CAL_RUN_SAMPLES];
+static uint16_t cal_count[CAL_NUM_INPUTS];
+// Inputs of the run still short of samples
+static uint32_t cal_pending;
+static int64_t cal_deadline_us;
+
+static int64_t cal_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void derive_threshold(int input) {
+    PadCalibration *c = &pad_calibration[input];
+
+    float th;
+    if (tracked[input] < CAL_TRACK_WARMUP) {
+        th = CAL_DEFAULT_THRESHOLD * cal_scale[input];
+    } else {
+        float margin = c->factor * c->noise;
+        if (margin < CAL_MIN_MARGIN * cal_scale[input]) margin = CAL_MIN_MARGIN * cal_scale[input];
+        th = c->offset + margin;
+    }
+    if (th > INT16_MAX) th = INT16_MAX;
+    c->threshold = (int16_t)th;
+}
+
+int calibration_init(const char *path) {
+    for (int i = 0; i < CAL_NUM_INPUTS; i++) {
+        pad_calibration[i].offset = 0;
+        pad_calibration[i].noise = 0;
+        pad_calibration[i].factor = CAL_DEFAULT_FACTOR;
+        cal_scale[i] = 1.0f;
+        tracked[i] = 0;
+        holdoff[i] = 0;
+        derive_threshold(i);
+    }
+
+    if (path != NULL) {
+        snprintf(cal_path, sizeof(cal_path), "%s", path);
+    }
+
+    FILE *f = fopen(cal_path, "r");
+    if (f == NULL) {
+        printf("No calibration file %s, using threshold %d\n", cal_path, CAL_DEFAULT_THRESHOLD);
+        return -1;
+    }
+
+    char line[128];
+    int loaded = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int input;
+        float offset, noise, factor;
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%d %f %f %f", &input, &offset, &noise, &factor) != 4) continue;
+        if (input < 0 || input >= CAL_NUM_INPUTS || factor <= 0) {
+            printf("%s: ignoring bad line: %s", cal_path, line);
+            continue;
+        }
+        pad_calibration[input].offset = offset * cal_scale[input];
+        pad_calibration[input].noise = noise * cal_scale[input];
+        pad_calibration[input].factor = factor;
+        tracked[input] = CAL_TRACK_WARMUP;
+        derive_threshold(input);
+        loaded++;
+    }
+    fclose(f);
+
+    printf("Loaded calibration for %d inputs from %s\n", loaded, cal_path);
+    return 0;
+}
+
+int calibration_save(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror("Saving calibration");
+        return -1;
+    }
+
+    fprintf(f, "# input offset noise factor, counts at +-6.144 V (threshold = offset + max(factor * noise, %d))\n", CAL_MIN_MARGIN);
+    for (int i = 0; i < CAL_NUM_INPUTS; i++) {
+        // Inputs that were never tracked (the pot) are left out
+        if (tracked[i] < CAL_TRACK_WARMUP) continue;
+        fprintf(f, "%d %.1f %.2f %.1f\n", i, (double)(pad_calibration[i].offset / cal_scale[i]),
+                (double)(pad_calibration[i].noise / cal_scale[i]), (double)pad_calibration[i].factor);
+    }
+    fclose(f);
+    return 0;
+}
+
+float calibration_set_scale(int input, float scale) {
+    if (input < 0 || input >= CAL_NUM_INPUTS) return 1.0f;
+
+    float ratio = scale / cal_scale[input];
+    pad_calibration[input].offset *= ratio;
+    pad_calibration[input].noise *= ratio;
+    cal_scale[input] = scale;
+    derive_threshold(input);
+    return ratio;
+}
+
+float calibration_scale(int input) {
+    if (input < 0 || input >= CAL_NUM_INPUTS) return 1.0f;
+    return cal_scale[input];
+}
+
+void calibration_start(uint32_t inputs) {
+    memset(cal_count, 0, sizeof(cal_count));
+    cal_pending = inputs;
+    cal_deadline_us = cal_now_us() + CAL_RUN_TIMEOUT_S * 1000000LL;
+    cal_running = cal_pending != 0;
+    printf("Calibrating, keep the pads still...\n");
+}
+
+bool calibration_running(void) {
+    return cal_running;
+}
+
+// Offset and noise of one input from the samples of the run
+static void calibration_compute(int input) {
+    PadCalibration *c = &pad_calibration[input];
+    int32_t sum = 0;
+    for (int n = 0; n < CAL_RUN_SAMPLES; n++) {
+        sum += cal_samples[input][n];
+    }
+    float mean = (float)sum / CAL_RUN_SAMPLES;
+
+    float dev = 0;
+    float max_dev = 0;
+    for (int n = 0; n < CAL_RUN_SAMPLES; n++) {
+        float d = fabsf(cal_samples[input][n] - mean);
+        dev += d;
+        if (d > max_dev) max_dev = d;
+    }
+
+    c->offset = mean;
+    c->noise = dev / CAL_RUN_SAMPLES;
+    tracked[input] = CAL_TRACK_WARMUP;
+    holdoff[input] = 0;
+    derive_threshold(input);
+
+    printf("Input %d: offset %.1f noise %.2f -> threshold %d\n", input, (double)c->offset, (double)c->noise, c->threshold);
+    if (max_dev > c->factor * c->noise + CAL_MIN_MARGIN * cal_scale[input]) {
+        printf("Input %d: peak %.0f counts off the offset, was the pad hit? Recalibrate\n", input, (double)max_dev);
+    }
+}
+
+static void calibration_sample(int input, int16_t value) {
+    if (cal_pending & (1u << input)) {
+        cal_samples[input][cal_count[input]++] = value;
+        if (cal_count[input] == CAL_RUN_SAMPLES) {
+            calibration_compute(input);
+            cal_pending &= ~(1u << input);
+        }
+    }
+
+    // Done once the slowest pad has its samples, or at the timeout with
+    // the thresholds of the missing ones left as they were
+    if (cal_pending != 0 && cal_now_us() < cal_deadline_us) {
+        return;
+    }
+    for (int i = 0; i < CAL_NUM_INPUTS; i++) {
+        if (cal_pending & (1u << i)) {
+            printf("Input %d: %d of %d samples in %d s, not calibrated, threshold stays %d\n", i, cal_count[i],
+                   CAL_RUN_SAMPLES, CAL_RUN_TIMEOUT_S, pad_calibration[i].threshold);
+        }
+    }
+    cal_pending = 0;
+    cal_running = false;
+    calibration_save(cal_path);
+    printf("Calibration saved to %s\n", cal_path);
+}
+
+void calibration_update(int input, int16_t value, bool triggered) {
+    if (input < 0 || input >= CAL_NUM_INPUTS) return;
+
+    if (cal_running) {
+        calibration_sample(input, value);
+        if (cal_running) return;
+    }
+
+    if (triggered) {
+        holdoff[input] = CAL_HOLDOFF;
+        return;
+    }
+    if (holdoff[input] > 0) {
+        holdoff[input]--;
+        return;
+    }
+
+    PadCalibration *c = &pad_calibration[input];
+    if (tracked[input] == 0) {
+        c->offset = value;
+        c->noise = 0;
+        tracked[input] = 1;
+        return;
+    }
+    float dev = value - c->offset;
+
+    // Anything past half the margin is likely a soft hit, not drift
+    if (tracked[input] >= CAL_TRACK_WARMUP && fabsf(dev) > (c->threshold - c->offset) / 2) {
+        return;
+    }
+
+    uint32_t n = tracked[input] < CAL_TRACK_WINDOW ? tracked[input] + 1 : CAL_TRACK_WINDOW;
+    c->offset += dev / n;
+    c->noise += (fabsf(dev) - c->noise) / n;
+
+    if (tracked[input] < CAL_TRACK_WARMUP) {
+        tracked[input]++;
+    }
+    derive_threshold(input);
+}
@@ -0,0 +1,63 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "topology.h"
+
+// One entry per value of the ADC frame handed to process_ads_triggers
+#define CAL_NUM_INPUTS TOPO_MAX_INPUTS
+
+// Threshold of a pad that was never calibrated (the old global ADS_THRESHOLD)
+#define CAL_DEFAULT_THRESHOLD 500
+
+// threshold = offset + max(factor * noise, CAL_MIN_MARGIN)
+#define CAL_DEFAULT_FACTOR 8.0f
+#define CAL_MIN_MARGIN     60
+
+// Samples per pad taken by a calibration run (~1.5 s at the usual frame rate)
+#define CAL_RUN_SAMPLES    256
+// A run gives up on the pads still short of samples after this long
+// (slow inputs, a chip gone offline) and names them
+#define CAL_RUN_TIMEOUT_S  10
+
+#define CAL_DEFAULT_FILE   "drumkit.cal"
+
+typedef struct {
+    float offset;   // DC level at rest, ADC counts
+    float noise;    // mean absolute deviation around offset, ADC counts
+    float factor;   // sensitivity, lower catches softer ghost notes
+    int16_t threshold;
+} PadCalibration;
+
+// Defaults that reproduce the fixed threshold, then loads path if it exists.
+// Returns 0 if the file was loaded
+int calibration_init(const char *path);
+int calibration_save(const char *path);
+
+// Starts a calibration run of inputs (one bit per input, the pads), they
+// must be at rest until every one of them has its samples. The result is
+// written to the path given to calibration_init
+void calibration_start(uint32_t inputs);
+bool calibration_running(void);
+
+// Gain of an input: counts per count at +-6.144 V (ads_scheduler_scale).
+// Offset, noise and the margins are kept in counts at the current gain
+// and converted when it changes, the file is always at +-6.144 V.
+// Returns the ratio new / old gain
+float calibration_set_scale(int input, float scale);
+// The gain last set, whatever the backend
+float calibration_scale(int input);
+
+// Feeds one sample of a pad. triggered tells whether the pad is inside a hit,
+// those samples (and the ring-out after them) do not move the estimate
+void calibration_update(int input, int16_t value, bool triggered);
+
+extern PadCalibration pad_calibration[CAL_NUM_INPUTS];
+
+static inline int16_t calibration_threshold(int input) {
+    return pad_calibration[input].threshold;
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "capture.h"
+#include "topology.h"
+#include "ads1115_reader.h"
+
+#define CAP_DATA_OFFSET  4096
+#define CAP_MAX_CAPACITY (1u << 24)
+
+static CapHeader *header;
+static uint8_t *ring;
+static uint32_t frame_size;
+static uint32_t capacity;
+static int num_inputs;
+
+// Full scale of every input, copied into each frame
+static uint16_t fsr_mv[TOPO_MAX_INPUTS];
+
+// A frame needs a new sample, so no more frames per second than the
+// chips convert at their fastest input
+static uint32_t max_frame_rate(void) {
+    uint8_t addrs[TOPO_MAX_CHIPS];
+    uint16_t sps[TOPO_MAX_CHIPS];
+    int chips = 0;
+    uint32_t rate = 0;
+
+    for (int i = 0; i < topology.num_inputs; i++) {
+        int c = 0;
+        while (c < chips && addrs[c] != topology.inputs[i].addr) c++;
+        if (c == chips) {
+            addrs[chips] = topology.inputs[i].addr;
+            sps[chips++] = 0;
+        }
+        if (topology.inputs[i].sps > sps[c]) sps[c] = topology.inputs[i].sps;
+    }
+    for (int c = 0; c < chips; c++) rate += sps[c];
+    return rate;
+}
+
+int capture_start(const char *path, int seconds) {
+    if (seconds <= 0) seconds = CAP_DEFAULT_SECONDS;
+    num_inputs = topology.num_inputs;
+    frame_size = (sizeof(CapFrame) + num_inputs * 2 * sizeof(int16_t) + 7) & ~7u;
+    capacity = 1;
+    while (capacity < (uint64_t)max_frame_rate() * seconds && capacity < CAP_MAX_CAPACITY) capacity <<= 1;
+
+    size_t size = CAP_DATA_OFFSET + (size_t)capacity * frame_size;
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+    // Blocks allocated now, a full card can not fault the loop later
+    int err = posix_fallocate(fd, 0, size);
+    if (err != 0) {
+        printf("%s: %s\n", path, strerror(err));
+        close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+    // Resident, the loop only takes the minor faults of the page writeback
+    if (mlock(map, size) < 0) {
+        perror("capture mlock");
+    }
+
+    CapHeader *h = map;
+    memcpy(h->magic, CAP_MAGIC, sizeof(CAP_MAGIC));
+    h->version = CAP_VERSION;
+    h->num_inputs = num_inputs;
+    h->frame_size = frame_size;
+    h->capacity = capacity;
+    h->data_offset = CAP_DATA_OFFSET;
+    atomic_store(&h->frames, 0);
+    atomic_store(&h->last_hit, 0);
+
+    for (int i = 0; i < num_inputs; i++) {
+        fsr_mv[i] = topology.inputs[i].fsr_mv ? topology.inputs[i].fsr_mv : TOPO_DEFAULT_FSR_MV;
+    }
+    ring = (uint8_t *)map + CAP_DATA_OFFSET;
+    header = h;
+    printf("Capturing ADC frames to %s, %u frames (%d s at up to %u frames/s)\n", path, capacity, seconds,
+           max_frame_rate());
+    return 0;
+}
+
+void capture_set_scale(int input, float scale) {
+    fsr_mv[input] = (uint16_t)(ADS1115_fsr_mv[ADS1115_PGA_6144] / scale + 0.5f);
+}
+
+void capture_frame(const int16_t values[], uint32_t fresh, uint32_t hits) {
+    if (header == NULL) return;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    unsigned n = atomic_load_explicit(&header->frames, memory_order_relaxed);
+    CapFrame *frame = (CapFrame *)(ring + (size_t)(n & (capacity - 1)) * frame_size);
+    frame->t_ns = (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+    frame->fresh = fresh;
+    frame->hits = hits;
+    memcpy(frame->data, values, num_inputs * sizeof(int16_t));
+    memcpy(frame->data + num_inputs, fsr_mv, num_inputs * sizeof(uint16_t));
+
+    atomic_store_explicit(&header->frames, n + 1, memory_order_release);
+    if (hits) atomic_store_explicit(&header->last_hit, n + 1, memory_order_release);
+}
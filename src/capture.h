@@ -0,0 +1,57 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+// Raw ADC capture for tuning the trigger detection: every acquisition
+// frame (all inputs, timestamped) goes into a ring in a preallocated file
+// mapped in memory, so a frame costs a copy and no syscall. The file is
+// sized for the fastest frame rate the topology allows, no frame is lost.
+// tools/capture_snap.c (make capture-snap) copies the last seconds, or the
+// seconds around the next hit, out of the running ring.
+//
+// File: a CapHeader, the ring at data_offset, frame n at n % capacity.
+
+#define CAP_MAGIC           "DRUMCAP"
+#define CAP_VERSION         1
+#define CAP_DEFAULT_SECONDS 30
+
+typedef struct {
+    char magic[8];          // CAP_MAGIC
+    uint32_t version;       // CAP_VERSION
+    uint32_t num_inputs;    // topology.num_inputs of the capture
+    uint32_t frame_size;    // bytes per frame, a multiple of 8
+    uint32_t capacity;      // frames in the ring, a power of two
+    uint32_t data_offset;   // of frame 0
+    uint32_t reserved;
+    // Frames written, wraps. Stored after the frame, a reader that sees
+    // n can read frames n - capacity + 1 to n - 1 (frame n - capacity is
+    // the one being overwritten)
+    atomic_uint frames;
+    // frames after the last frame with a hit, 0 before the first one
+    atomic_uint last_hit;
+} CapHeader;
+
+typedef struct {
+    uint64_t t_ns;          // CLOCK_MONOTONIC
+    uint32_t fresh;         // inputs sampled in this frame, the others repeat
+    uint32_t hits;          // inputs that triggered in this frame
+    // num_inputs raw counts, then num_inputs PGA full scales in mV
+    int16_t data[];
+} CapFrame;
+
+_Static_assert(sizeof(CapFrame) == 16, "frame header is 16 bytes");
+
+// Creates path (replacing it) for the topology and maps it. -1 on error,
+// nothing is captured then
+int capture_start(const char *path, int seconds);
+
+// Full scale of the input's samples from now on, 6.144 V / scale (like
+// calibration_set_scale)
+void capture_set_scale(int input, float scale);
+
+// One frame as the trigger detection saw it, no-op while not capturing
+void capture_frame(const int16_t values[], uint32_t fresh, uint32_t hits);
+
+#endif
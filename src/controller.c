@@ -0,0 +1,503 @@
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <linux/input.h>
+
+#include "lvgl/lvgl.h"
+#include "ui/ui.h"
+#include "controller.h"
+#include "calibration.h"
+#include "ads_scheduler.h"
+#include "trigger_out.h"
+#include "recorder.h"
+#include "capture.h"
+#include "synth_control.h"
+#include "seq_patterns.h"
+#include "sound_params.h"
+
+_Static_assert(NUM_CHANNELS <= UI_MAX_CHANNELS, "a panel per channel");
+
+// Channel to sound, filled from the topology by controller_init().
+// Seqlock: map_seq is odd while set_channel_mapping writes, a reader
+// retries when it changed under it. The entries are atomics so the
+// racing reads are defined, relaxed is enough inside the sequence
+static atomic_uint map_seq;
+static _Atomic uint8_t map_sound[NUM_CHANNELS];
+
+// BPM change of one LEFT / RIGHT press on the sequencer screen
+#define SEQ_BPM_STEP 2
+
+static int current_panel_index = 0;
+static int current_screen = 0;
+
+// What ui_Screen3 shows, sent to the sequencer in the synth on every change
+static int seq_pattern = 0;
+static int seq_bpm = SEQ_DEFAULT_BPM;
+static bool seq_running = false;
+
+// Sound parameters as last sent, and the sound ui_Screen4 edits
+static float param_values[SOUND_PARAM_COUNT];
+static char param_paths[SOUND_PARAM_COUNT][48];
+static int edit_first;
+static int edit_count;
+static int edit_row;
+
+void controller_init(void) {
+    ui_channel_cell_t cells[TOPO_MAX_CHANNELS];
+
+    for (int ch = 0; ch < topology.num_channels; ch++) {
+        atomic_store_explicit(&map_sound[ch], topology.channels[ch].sound, memory_order_relaxed);
+        cells[ch].col = topology.channels[ch].col;
+        cells[ch].row = topology.channels[ch].row;
+    }
+    atomic_store_explicit(&map_seq, 0, memory_order_release);
+    for (int i = 0; i < SOUND_PARAM_COUNT; i++) {
+        param_values[i] = sound_params[i].init;
+        snprintf(param_paths[i], sizeof(param_paths[i]), "/drumkit/%s/%s",
+                 sound_names[sound_params[i].sound], sound_params[i].name);
+    }
+    ui_Screen1_set_channel_grid(cells, topology.num_channels, topology.cols, topology.rows);
+}
+
+lv_obj_t* get_panel(uint8_t index) {
+    if (index >= topology.num_channels) {
+        printf("Error: Panel index %d out of bounds\n", index);
+        return NULL;
+    }
+    
+    if (ui_Channel[index] == NULL) {
+        printf("Error: Panel %d object is NULL\n", index);
+        return NULL;
+    }
+    return ui_Channel[index];
+}
+
+static int panel_at(int col, int row) {
+    for (int ch = 0; ch < topology.num_channels; ch++) {
+        if (topology.channels[ch].col == col && topology.channels[ch].row == row) return ch;
+    }
+    return -1;
+}
+
+// Next panel from the current one in a direction, wrapping around the
+// grid and skipping empty cells
+static int panel_step(int dx, int dy) {
+    int col = topology.channels[current_panel_index].col;
+    int row = topology.channels[current_panel_index].row;
+
+    for (int n = 0; n < TOPO_MAX_GRID; n++) {
+        col = (col + dx + topology.cols) % topology.cols;
+        row = (row + dy + topology.rows) % topology.rows;
+        int ch = panel_at(col, row);
+        if (ch >= 0) return ch;
+    }
+    return current_panel_index;
+}
+
+// Moves the highlight by toggling LV_STATE_FOCUSED, the colors come from the shared panel styles
+void select_panel(int index) {
+    lv_obj_t* prev = get_panel(current_panel_index);
+    lv_obj_t* next = get_panel(index);
+    if (prev == NULL || next == NULL) {
+        return;
+    }
+
+    lv_obj_remove_state(prev, LV_STATE_FOCUSED);
+    lv_obj_add_state(next, LV_STATE_FOCUSED);
+    current_panel_index = index;
+}
+
+void set_channel_mapping(int channel, SoundType sound) {
+    if (channel < 0 || channel >= topology.num_channels) {
+        printf("Invalid channel: %d\n", channel);
+        return;
+    }
+    if (sound < 0 || sound >= SOUND_COUNT) {
+        printf("Invalid sound: %d\n", sound);
+        return;
+    }
+    
+    unsigned seq = atomic_load_explicit(&map_seq, memory_order_relaxed);
+    atomic_store_explicit(&map_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&map_sound[channel], sound, memory_order_relaxed);
+    atomic_store_explicit(&map_seq, seq + 2, memory_order_release);
+    printf("Channel %d mapped to %s\n", channel, sound_names[sound]);
+}
+
+SoundType channel_sound(int channel) {
+    return atomic_load_explicit(&map_sound[channel], memory_order_relaxed);
+}
+
+void channel_map_snapshot(ChannelMap *map) {
+    unsigned seq;
+    do {
+        while ((seq = atomic_load_explicit(&map_seq, memory_order_acquire)) & 1) {
+        }
+        for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+            map->sound[ch] = atomic_load_explicit(&map_sound[ch], memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_acquire);
+    } while (atomic_load_explicit(&map_seq, memory_order_relaxed) != seq);
+}
+
+void setup_sound_roller(lv_obj_t* roller) {
+    // Create the options string for the roller
+    // LVGL roller expects options separated by '\n'
+    char options[256] = "";
+    
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        strcat(options, sound_names[i]);
+        if (i < SOUND_COUNT - 1) {
+            strcat(options, "\n");
+        }
+    }
+    
+    lv_roller_set_options(roller, options, LV_ROLLER_MODE_NORMAL);
+
+    lv_roller_set_selected(roller, channel_sound(current_panel_index), LV_ANIM_OFF);
+}
+
+// Function to update the roller when switching channels
+void update_roller_for_channel(lv_obj_t* roller) {
+    lv_roller_set_selected(roller, channel_sound(current_panel_index), LV_ANIM_OFF);
+}
+
+void setup_seq_screen(void) {
+    char options[256] = "";
+
+    for (int i = 0; i < SEQ_NUM_PATTERNS; i++) {
+        strcat(options, seq_pattern_names[i]);
+        if (i < SEQ_NUM_PATTERNS - 1) {
+            strcat(options, "\n");
+        }
+    }
+    lv_roller_set_options(ui_Roller2, options, LV_ROLLER_MODE_NORMAL);
+    lv_roller_set_selected(ui_Roller2, seq_pattern, LV_ANIM_OFF);
+    ui_Screen3_show_seq(seq_bpm, seq_running);
+}
+
+static void seq_set_pattern(int pattern) {
+    seq_pattern = pattern;
+    lv_roller_set_selected(ui_Roller2, pattern, LV_ANIM_OFF);
+    synth_control_int(SEQ_PATH_PATTERN, pattern);
+}
+
+// Coalesced, a held key sends one tempo per frame
+static void seq_set_bpm(int bpm) {
+    if (bpm < SEQ_MIN_BPM) bpm = SEQ_MIN_BPM;
+    if (bpm > SEQ_MAX_BPM) bpm = SEQ_MAX_BPM;
+    seq_bpm = bpm;
+    ui_Screen3_show_seq(seq_bpm, seq_running);
+    synth_control_set(SEQ_PATH_TEMPO, (float)bpm);
+}
+
+// Starting sends the whole setting first, the synth may have restarted since
+static void seq_toggle(void) {
+    seq_running = !seq_running;
+    if (seq_running) {
+        synth_control_int(SEQ_PATH_PATTERN, seq_pattern);
+        synth_control_set(SEQ_PATH_TEMPO, (float)seq_bpm);
+    }
+    synth_control_flush();
+    synth_control_int(SEQ_PATH_RUN, seq_running);
+    ui_Screen3_show_seq(seq_bpm, seq_running);
+}
+
+static void edit_show_row(int row) {
+    const SoundParam *p = &sound_params[edit_first + row];
+    float v = param_values[edit_first + row];
+    lv_slider_set_value(ui_SliderParam[row], (int32_t)((v - p->min) * 1000 / (p->max - p->min)), LV_ANIM_OFF);
+    lv_label_set_text_fmt(ui_LabelParamValue[row], "%.*f %s", p->decimals, (double)v, p->unit);
+}
+
+static void edit_select_row(int row) {
+    lv_obj_remove_state(ui_SliderParam[edit_row], LV_STATE_FOCUSED);
+    lv_obj_add_state(ui_SliderParam[row], LV_STATE_FOCUSED);
+    edit_row = row;
+}
+
+// Fills ui_Screen4 with the parameters of sound, unused rows hidden
+static void edit_open(SoundType sound) {
+    edit_first = sound_params_of(sound, &edit_count);
+    if (edit_count > UI_EDIT_ROWS) edit_count = UI_EDIT_ROWS;
+    lv_label_set_text_static(ui_LabelEditSound, sound_names[sound]);
+
+    for (int row = 0; row < UI_EDIT_ROWS; row++) {
+        lv_obj_t *objs[] = {ui_LabelParam[row], ui_SliderParam[row], ui_LabelParamValue[row]};
+        for (int i = 0; i < 3; i++) {
+            if (row < edit_count) lv_obj_remove_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+            else lv_obj_add_flag(objs[i], LV_OBJ_FLAG_HIDDEN);
+        }
+        if (row < edit_count) {
+            lv_label_set_text_static(ui_LabelParam[row], sound_params[edit_first + row].name);
+            edit_show_row(row);
+        }
+    }
+    edit_select_row(0);
+}
+
+// One step of the selected parameter, coalesced: a sweep sends one value per frame
+static void edit_step(int dir) {
+    if (edit_count == 0) return;
+    int i = edit_first + edit_row;
+    const SoundParam *p = &sound_params[i];
+    float v = param_values[i] + dir * p->step;
+    if (v < p->min) v = p->min;
+    if (v > p->max) v = p->max;
+    param_values[i] = v;
+    edit_show_row(edit_row);
+    synth_control_set(param_paths[i], v);
+}
+
+// A hit of pad (topology input or REC_PAD_KEY) routed through the mapping
+// snapshot map, it leaves with the next flush
+static void queue_hit(const ChannelMap *map, int pad, int channel, float velocity) {
+    if (channel < 0 || channel >= topology.num_channels) {
+        printf("Invalid channel: %d\n", channel);
+        return;
+    }
+    trigger_out_hit(map->sound[channel], velocity);
+    recorder_hit(pad, map->sound[channel], velocity);
+}
+
+static void flush_hits(void) {
+    trigger_out_flush();
+    recorder_frame_end();
+}
+
+void set_channel_trigger(int channel, float velocity) {
+    ChannelMap map;
+    channel_map_snapshot(&map);
+    queue_hit(&map, REC_PAD_KEY, channel, velocity);
+    flush_hits();
+}
+
+// Velocity from the first sample over the threshold: VELOCITY_MIN just
+// over it up to 1 at +-6.144 V full scale. In counts at +-6.144 V, the
+// same hit gives the same velocity whatever gain the pad is at
+static float hit_velocity(int input, int16_t value, int16_t threshold) {
+    float scale = calibration_scale(input);
+    float over = (value - threshold) / scale;
+    float range = INT16_MAX - threshold / scale;
+    if (range <= 0) return 1.0f;
+    float v = over / range;
+    if (v < 0) v = 0;
+    if (v > 1) v = 1;
+    return VELOCITY_MIN + (1.0f - VELOCITY_MIN) * v;
+}
+
+
+static int16_t prev_ads_values[TOPO_MAX_INPUTS] = {0};
+static bool ads_triggered[TOPO_MAX_INPUTS] = {false};
+
+uint32_t process_ads_triggers(int16_t values[TOPO_MAX_INPUTS], uint32_t fresh) {
+    // One mapping for the whole frame
+    ChannelMap map;
+    channel_map_snapshot(&map);
+    uint32_t hits = 0;
+
+    for (int ads_ch = 0; ads_ch < topology.num_inputs; ads_ch++) {
+        // Not sampled in this frame (multi-rate scheduling)
+        if (!(fresh & (1u << ads_ch))) {
+            continue;
+        }
+
+        // Obtener el canal Faust correspondiente (la topología)
+        int faust_ch = topology.inputs[ads_ch].channel;
+        
+        // Saltar si no es un pad (el potenciómetro)
+        if (faust_ch < 0) {
+            continue;
+        }
+        
+        int16_t current_value = values[ads_ch];
+        int16_t prev_value = prev_ads_values[ads_ch];
+        int16_t threshold = calibration_threshold(ads_ch);
+
+        // Noise floor / offset tracking, also feeds a calibration run
+        calibration_update(ads_ch, current_value, ads_triggered[ads_ch]);
+        if (calibration_running()) {
+            prev_ads_values[ads_ch] = current_value;
+            continue;
+        }
+        
+        // Detectar rising edge (cruzar el threshold hacia arriba)
+        if (!ads_triggered[ads_ch] && current_value > threshold && prev_value <= threshold) {
+            // Un solo mensaje por golpe, el synth cierra la envolvente solo
+            float velocity = hit_velocity(ads_ch, current_value, threshold);
+            queue_hit(&map, ads_ch, faust_ch, velocity);
+            ads_triggered[ads_ch] = true;
+            hits |= 1u << ads_ch;
+            // Follow the ring-out closely for fast re-hits
+            ads_scheduler_boost(ads_ch);
+            printf("ADS ch%d triggered -> Faust ch%d (value: %d, velocity %.2f)\n", ads_ch + 1, faust_ch,
+                   current_value, (double)velocity);
+        }
+        // Back under the threshold, armed for the next hit
+        else if (ads_triggered[ads_ch] && current_value <= threshold) {
+            ads_triggered[ads_ch] = false;
+        }
+        
+        // Actualizar valor anterior
+        prev_ads_values[ads_ch] = current_value;
+    }
+
+    // Todos los golpes del frame en un solo paquete
+    flush_hits();
+    return hits;
+}
+
+void rescale_ads_inputs(uint32_t inputs) {
+    for (int ads_ch = 0; ads_ch < topology.num_inputs; ads_ch++) {
+        if (!(inputs & (1u << ads_ch))) {
+            continue;
+        }
+        // The edge detection compares with the previous sample, at the old gain
+        float scale = ads_scheduler_scale(ads_ch);
+        float prev = prev_ads_values[ads_ch] * calibration_set_scale(ads_ch, scale);
+        capture_set_scale(ads_ch, scale);
+        prev_ads_values[ads_ch] = prev > INT16_MAX ? INT16_MAX : prev < INT16_MIN ? INT16_MIN : (int16_t)prev;
+        printf("ADS ch%d gain now %.0f mV full scale\n", ads_ch + 1, 6144 / (double)scale);
+    }
+}
+
+void handle_key_event(uint16_t code, int32_t value) {
+    // A held LEFT / RIGHT repeats (value 2) where it sweeps a value: tempo, sound parameters
+    if (value == 2 && current_screen >= 2 && (code == KEY_LEFT || code == KEY_RIGHT)) {
+        value = 1;
+    }
+    if(value == 1){
+        if(current_screen == 0){
+            switch (code) {
+                case KEY_UP: 
+                    select_panel(panel_step(0, -1));
+                    break;
+                case KEY_DOWN: 
+                    select_panel(panel_step(0, 1));
+                    break;
+                case KEY_LEFT: 
+                    select_panel(panel_step(-1, 0));
+                    break;
+                case KEY_RIGHT: 
+                    select_panel(panel_step(1, 0));
+                    break;
+                case KEY_ENTER:
+                    lv_screen_load(ui_Screen2);  
+                    update_roller_for_channel(ui_Roller1);
+                    current_screen = 1;              
+                    break;
+                case KEY_ESC: 
+                    set_channel_trigger(current_panel_index,1.0f);
+                    break;
+                default:
+                    break;
+            }
+        }else if(current_screen == 1){
+            switch (code) {
+                case KEY_UP: 
+                    if (channel_sound(current_panel_index) > 0) {
+                        lv_roller_set_selected(ui_Roller1, channel_sound(current_panel_index)-1,LV_ANIM_OFF);
+                        set_channel_mapping(current_panel_index, channel_sound(current_panel_index)-1);
+                    }
+                    break;
+                case KEY_DOWN: 
+                    if (channel_sound(current_panel_index) < (SOUND_COUNT-1)) {
+                        lv_roller_set_selected(ui_Roller1, channel_sound(current_panel_index)+1,LV_ANIM_OFF);
+                        set_channel_mapping(current_panel_index, channel_sound(current_panel_index)+1);
+                    }
+                    break;
+                case KEY_LEFT: 
+                    edit_open(channel_sound(current_panel_index));
+                    lv_screen_load(ui_Screen4);
+                    current_screen = 3;
+                    break;
+                case KEY_RIGHT: 
+                    lv_screen_load(ui_Screen3);
+                    current_screen = 2;
+                    break;
+                case KEY_ENTER:
+                    lv_screen_load(ui_Screen1);           
+                    current_screen = 0;     
+                    break;
+                case KEY_ESC: 
+                    set_channel_trigger(current_panel_index,1.0f);
+                    break;
+                default:
+                    break;
+            }
+        }else if(current_screen == 3){
+            // Sound parameters: row up / down, value left / right, ESC plays the sound
+            switch (code) {
+                case KEY_UP:
+                    if (edit_row > 0) {
+                        edit_select_row(edit_row - 1);
+                    }
+                    break;
+                case KEY_DOWN:
+                    if (edit_row < edit_count - 1) {
+                        edit_select_row(edit_row + 1);
+                    }
+                    break;
+                case KEY_LEFT:
+                    edit_step(-1);
+                    break;
+                case KEY_RIGHT:
+                    edit_step(1);
+                    break;
+                case KEY_ENTER:
+                    lv_screen_load(ui_Screen2);
+                    current_screen = 1;
+                    break;
+                case KEY_ESC:
+                    set_channel_trigger(current_panel_index,1.0f);
+                    break;
+                default:
+                    break;
+            }
+        }else{
+            // Sequencer: pattern up / down, tempo left / right, ENTER starts and stops
+            switch (code) {
+                case KEY_UP:
+                    if (seq_pattern > 0) {
+                        seq_set_pattern(seq_pattern - 1);
+                    }
+                    break;
+                case KEY_DOWN:
+                    if (seq_pattern < SEQ_NUM_PATTERNS - 1) {
+                        seq_set_pattern(seq_pattern + 1);
+                    }
+                    break;
+                case KEY_LEFT:
+                    seq_set_bpm(seq_bpm - SEQ_BPM_STEP);
+                    break;
+                case KEY_RIGHT:
+                    seq_set_bpm(seq_bpm + SEQ_BPM_STEP);
+                    break;
+                case KEY_ENTER:
+                    seq_toggle();
+                    break;
+                case KEY_ESC:
+                    lv_screen_load(ui_Screen1);
+                    current_screen = 0;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+    }
+}
+
+void process_keyev(int file) {
+    struct input_event ie;
+    
+    // Every event queued since the last frame: the repeats of a held key
+    // are handled together and their synth_control_set values coalesce
+    while (read(file, &ie, sizeof(struct input_event)) == sizeof(struct input_event)) {
+        if (ie.type == EV_KEY) {
+            handle_key_event(ie.code, ie.value);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef CONTROLLER_H
+#define CONTROLLER_H
+
+#include <stdint.h>
+
+#include "lvgl/lvgl.h"
+#include "topology.h"
+#include "sounds.h"
+
+// Room for the largest topology, topology.num_channels are in use
+#define NUM_CHANNELS TOPO_MAX_CHANNELS
+
+// Velocity of the softest hit a pad can send, see hit_velocity
+#define VELOCITY_MIN 0.2f
+
+// Sound of every channel at one point in time
+typedef struct {
+    uint8_t sound[NUM_CHANNELS];
+} ChannelMap;
+
+// Channel sounds and panel grid from the topology, before ui_init()
+void controller_init(void);
+
+lv_obj_t* get_panel(uint8_t index);
+void select_panel(int index);
+
+// The mapping has one writer (the key handler) and is read without locks
+// from any thread: a reader never sees a half written table
+void set_channel_mapping(int channel, SoundType sound);
+SoundType channel_sound(int channel);
+void channel_map_snapshot(ChannelMap *map);
+
+void setup_sound_roller(lv_obj_t* roller);
+void update_roller_for_channel(lv_obj_t* roller);
+// Pattern roller and labels of the sequencer screen (ui_Screen3), after ui_init()
+void setup_seq_screen(void);
+
+// One hit of the current sound of the channel, velocity 0-1, sent right
+// away through the trigger output (trigger_out.h). A single message, the
+// envelope in drumkit.dsp runs and closes by itself
+void set_channel_trigger(int channel, float velocity);
+// Runs the inputs set in the fresh mask through the trigger detection,
+// the hits of the frame leave together (one OSC packet, one MIDI write).
+// Returns the mask of inputs that triggered
+uint32_t process_ads_triggers(int16_t values[TOPO_MAX_INPUTS], uint32_t fresh);
+// Moves the pad state of inputs whose gain changed (auto-range) to the new gain
+void rescale_ads_inputs(uint32_t inputs);
+
+// Applies one D-pad key event (code from linux/input.h, value 1 = press, 0 = release)
+void handle_key_event(uint16_t code, int32_t value);
+// Reads the pending events from the evdev file and hands them to handle_key_event
+void process_keyev(int file);
+
+#endif
@@ -1,19 +1,61 @@
+// The root of every OSC path (/drumkit/...), whatever the file is called:
+// a variant swapped into a running synth (synth/dsp_swap.h) has to keep it
+declare name "drumkit";
 declare options "[osc:on]";
 import("stdfaust.lib");
 
+// One OSC message per hit: /drumkit/<Sound> with 2 * count + velocity,
+// count counting the hits of the writer modulo hitCounts and velocity
+// 0-1 (sound_hit_value, src/sounds.h). Every hit changes the value, even
+// two at the same velocity in one block. There is no release message, the
+// gate closes by itself
+hitCounts = 1024;
+hit(name) = hslider(name, 0, 0, 2 * hitCounts, 0.001);
+hitVelocity(x) = fmod(x, 2);
+// Steps of the sequencer in the synth (synth/sequencer.h) come in on
+// /drumkit/Seq/<Sound>, a replay (tools/replay.c) on /drumkit/Replay/<Sound>,
+// same protocol. Each control has a single writer
+hitHold = 0.005;
+trig(x) = x != x';
+// A change of any control of a sound is a hit
+hitTrig(p, s, r) = trig(p) | trig(s) | trig(r);
+// Open for hitHold after a hit, closed for the hit sample itself so a
+// hit during the gate restarts the attack
+hitGate(p, s, r) = (ba.countdown(ba.sec2samp(hitHold), hitTrig(p, s, r)) > 0) * (1 - hitTrig(p, s, r));
+// Velocity of the last hit, held until the next one. It scales the
+// whole model, tail of the previous hit included: the change glides over
+// a few ms instead of stepping the level of a sound still ringing
+velGlide = 0.002;
+hitVel(p, s, r) = select2(trig(r), select2(trig(s), hitVelocity(p), hitVelocity(s)), hitVelocity(r))
+    : ba.sAndH(hitTrig(p, s, r)) : si.smooth(ba.tau2pole(velGlide));
+
+kickHit = hit("Kick"), hit("h:Seq/Kick"), hit("h:Replay/Kick");
+bassHit = hit("BassTom"), hit("h:Seq/BassTom"), hit("h:Replay/BassTom");
+medHit = hit("MedTom"), hit("h:Seq/MedTom"), hit("h:Replay/MedTom");
+highHit = hit("HighTom"), hit("h:Seq/HighTom"), hit("h:Replay/HighTom");
+snareHit = hit("Snare"), hit("h:Seq/Snare"), hit("h:Replay/Snare");
+hihatHit = hit("Hihat"), hit("h:Seq/Hihat"), hit("h:Replay/Hihat");
+hihatOpenHit = hit("OpenHihat"), hit("h:Seq/OpenHihat"), hit("h:Replay/OpenHihat");
+crashHit = hit("Crash"), hit("h:Seq/Crash"), hit("h:Replay/Crash");
+
+// Sound parameters: /drumkit/<Sound>/<Param> f, edited from the controller
+// (src/sound_params.c has the same table). Smoothed, a sweep changes them
+// every UI frame and the steps would be heard
+param(label, init, lo, hi, step) = hslider(label, init, lo, hi, step) : si.smoo;
+
 // Gate inputs for each drum
-kickGate = button("Kick");
-bassGate = button("BassTom");
-medGate = button("MedTom");
-highGate = button("HighTom");
-snareGate = button("Snare");
-hihatGate = button("Hihat");
-hihatOpenGate = button("OpenHihat");
-crashGate = button("Crash");
+kickGate = kickHit : hitGate;
+bassGate = bassHit : hitGate;
+medGate = medHit : hitGate;
+highGate = highHit : hitGate;
+snareGate = snareHit : hitGate;
+hihatGate = hihatHit : hitGate;
+hihatOpenGate = hihatOpenHit : hitGate;
+crashGate = crashHit : hitGate;
 
 // KICK DRUM (your original code)
-k_freq = 40;
-k_decay = 0.7;
+k_freq = param("h:Kick/Tune", 40, 25, 80, 1);
+k_decay = param("h:Kick/Decay", 0.7, 0.1, 2, 0.01);
 k_click_decay = 0.05;
 k_envelope = kickGate : en.ar(0.001, k_decay);
 k_freq_sweep = k_freq * (1+k_envelope);
@@ -21,12 +63,13 @@ k_main_osc = os.osc(k_freq_sweep) * k_envelope;
 k_click_env = kickGate : en.ar(0.0001, k_click_decay);
 k_click_osc = no.noise * k_click_env * 0.5;
 k_click_filtered = k_click_osc : fi.highpass(1, 1000);
-k_main_filtered = k_main_osc : fi.lowpass(2, 150);
+k_tone = param("h:Kick/Tone", 150, 60, 600, 10);
+k_main_filtered = k_main_osc : fi.lowpass(2, k_tone);
 kickModel = (1.5*k_main_filtered + k_click_filtered);
 
 // BASS TOM
-bt_freq = 85;
-bt_decay = 0.8;
+bt_freq = param("h:BassTom/Tune", 85, 50, 150, 1);
+bt_decay = param("h:BassTom/Decay", 0.8, 0.1, 2, 0.01);
 bt_click_decay = 0.03;
 bt_envelope = bassGate : en.ar(0.002, bt_decay);
 bt_freq_sweep = bt_freq * (1 + 2 * bt_envelope);
@@ -38,8 +81,8 @@ bt_main_filtered = bt_main_osc : fi.lowpass(2, 200);
 bassTomModel = (bt_main_filtered + bt_click_filtered);
 
 // MEDIUM TOM
-mt_freq = 130;
-mt_decay = 0.6;
+mt_freq = param("h:MedTom/Tune", 130, 80, 220, 1);
+mt_decay = param("h:MedTom/Decay", 0.6, 0.1, 2, 0.01);
 mt_click_decay = 0.025;
 mt_envelope = medGate : en.ar(0.002, mt_decay);
 mt_freq_sweep = mt_freq * (1 + 1.5 * mt_envelope);
@@ -51,8 +94,8 @@ mt_main_filtered = mt_main_osc : fi.lowpass(2, 300);
 medTomModel = (mt_main_filtered + mt_click_filtered);
 
 // HIGH TOM
-ht_freq = 200;
-ht_decay = 0.4;
+ht_freq = param("h:HighTom/Tune", 200, 120, 350, 1);
+ht_decay = param("h:HighTom/Decay", 0.4, 0.1, 1.5, 0.01);
 ht_click_decay = 0.02;
 ht_envelope = highGate : en.ar(0.001, ht_decay);
 ht_freq_sweep = ht_freq * (1 + 1.2 * ht_envelope);
@@ -64,9 +107,9 @@ ht_main_filtered = ht_main_osc : fi.lowpass(2, 400);
 highTomModel = (ht_main_filtered + ht_click_filtered);
 
 // SNARE DRUM
-s_freq = 220;
-s_decay = 0.15;
-s_noise_decay = 0.12;
+s_freq = param("h:Snare/Tune", 220, 120, 400, 1);
+s_decay = param("h:Snare/Decay", 0.15, 0.05, 0.6, 0.01);
+s_noise_decay = param("h:Snare/Snappy", 0.12, 0.03, 0.5, 0.01);
 s_envelope = snareGate : en.ar(0.001, s_decay);
 s_freq_sweep = s_freq * (1 + 0.5 * s_envelope);
 s_tone_osc = os.osc(s_freq_sweep) * s_envelope * 0.3;
@@ -77,16 +120,18 @@ s_tone_filtered = s_tone_osc : fi.lowpass(2, 500);
 snareModel = (s_tone_filtered + s_noise_filtered);
 
 // HIHAT
-h_decay = 0.08;
+h_decay = param("h:Hihat/Decay", 0.08, 0.02, 0.4, 0.01);
 h_envelope = hihatGate : en.ar(0.0001, h_decay);
 h_noise = no.noise * h_envelope;
-h_filtered = h_noise : fi.highpass(2, 8000) : fi.lowpass(2, 15000);
+h_tone = param("h:Hihat/Tone", 8000, 3000, 12000, 100);
+h_filtered = h_noise : fi.highpass(2, h_tone) : fi.lowpass(2, 15000);
 hihatModel = h_filtered;
 
-hihat_open_decay = 0.5;
+hihat_open_decay = param("h:OpenHihat/Decay", 0.5, 0.1, 2, 0.01);
 hihat_open_envelope = hihatOpenGate : en.ar(0.001, hihat_open_decay);
 hihat_open_noise = no.noise * hihat_open_envelope;
-hihat_open_filtered = hihat_open_noise : fi.highpass(2, 6000) : fi.lowpass(2, 15000);
+hihat_open_tone = param("h:OpenHihat/Tone", 6000, 2000, 12000, 100);
+hihat_open_filtered = hihat_open_noise : fi.highpass(2, hihat_open_tone) : fi.lowpass(2, 15000);
 hihatOpenModel = hihat_open_filtered;
 
 // RIDE CYMBAL (based on the synthesis image)
@@ -96,17 +141,20 @@ r_fast_env = crashGate : en.ar(0.001, 0.1);
 
 // Multiple oscillators with harmonic relationships (like in the image)
 
-crash_decay = 1;
+crash_decay = param("h:Crash/Decay", 1, 0.3, 4, 0.01);
 crash_envelope = crashGate : en.ar(0.002, crash_decay);
 crash_noise = no.noise * crash_envelope;
-crash_filtered = crash_noise : fi.highpass(2, 3000) : fi.lowpass(1, 18000);
+crash_tone = param("h:Crash/Tone", 3000, 1000, 8000, 100);
+crash_filtered = crash_noise : fi.highpass(2, crash_tone) : fi.lowpass(1, 18000);
 crash_sound = crash_filtered * 0.6;
 
 // Combine components
 crashModel = crash_sound;
 
 // MIX ALL DRUMS
-drumKit = kickModel + bassTomModel + medTomModel + highTomModel + snareModel + hihatModel + hihatOpenModel + crashModel;
+drumKit = kickModel * (kickHit : hitVel) + bassTomModel * (bassHit : hitVel) + medTomModel * (medHit : hitVel) +
+          highTomModel * (highHit : hitVel) + snareModel * (snareHit : hitVel) + hihatModel * (hihatHit : hitVel) +
+          hihatOpenModel * (hihatOpenHit : hitVel) + crashModel * (crashHit : hitVel);
 
 // OUTPUT
 process = drumKit <: _, _;
\ No newline at end of file
@@ -4,17 +4,28 @@
 #include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
-#include <lo/lo.h>
+#include <stdatomic.h>
+#include <sys/time.h>
 #include <linux/input.h>
 
 #include "lvgl/lvgl.h"
 #include "ui/ui.h"
+#include "controller.h"
+#include "calibration.h"
+#include "topology.h"
+#include "ads1115_reader.h"
+#include "ads_scheduler.h"
+#include "ads_iio.h"
+#include "ads_replay.h"
+#include "trigger_out.h"
+#include "synth_control.h"
+#include "recorder.h"
+#include "capture.h"
+#include "startup_log.h"
 #include "src/lib/driver_backends.h"
 #include "src/lib/simulator_util.h"
 #include "src/lib/simulator_settings.h"
 
-#define ADS_THRESHOLD 500
-
 /* contains the name of the selected backend if user
  * has specified one on the command line */
 static char *selected_backend;
@@ -22,79 +33,6 @@ static char *selected_backend;
 /* Global simulator settings, defined in lv_linux_backend.c */
 extern simulator_settings_t settings;
 
-typedef struct {
-    lv_obj_t **panel;  // Pointer to the panel reference
-    int16_t grid_x;
-    int16_t grid_y;
-} PanelInfo;
-
-// Pointers to SquareLine's panel references
-static PanelInfo panels[] = {
-    {&ui_Channel1, 0, 0},
-    {&ui_Channel2, 1, 0},
-    {&ui_Channel3, 2, 0},
-    {&ui_Channel4, 0, 1},
-    {&ui_Channel5, 1, 1},
-    {&ui_Channel6, 2, 1}
-};
-
-typedef enum {
-    SOUND_KICK = 0,
-    SOUND_SNARE,
-    SOUND_HIHAT,
-    SOUND_OPEN_HIHAT,
-    SOUND_BASS_TOM,
-    SOUND_MED_TOM,
-    SOUND_HIGH_TOM,
-    SOUND_CRASH,
-    SOUND_COUNT  // Total number of sounds
-} SoundType;
-
-// Sound names for OSC paths and display
-const char* sound_names[SOUND_COUNT] = {
-    "Kick",
-    "Snare", 
-    "Hihat",
-    "OpenHihat",
-    "BassTom",
-    "MedTom",
-    "HighTom",
-    "Crash"
-};
-
-
-#define NUM_CHANNELS 6
-SoundType channel_mapping[NUM_CHANNELS] = {
-    SOUND_KICK,      // Channel 0 -> Kick
-    SOUND_SNARE,     // Channel 1 -> Snare
-    SOUND_HIHAT,     // Channel 2 -> Hihat
-    SOUND_OPEN_HIHAT,// Channel 3 -> Open Hihat
-    SOUND_BASS_TOM,  // Channel 4 -> Bass Tom
-    SOUND_CRASH      // Channel 5 -> Crash
-};
-
-static int current_panel_index = 0;
-static int triggered_channel = 6;
-static int current_screen = 0;
-
-static lv_obj_t* get_panel(uint8_t index) {
-    if (index >= sizeof(panels)/sizeof(PanelInfo)) {
-        printf("Error: Panel index %d out of bounds\n", index);
-        return NULL;
-    }
-    
-    if (panels[index].panel == NULL) {
-        printf("Error: Panel %d pointer is NULL\n", index);
-        return NULL;
-    }
-    
-    if (*panels[index].panel == NULL) {
-        printf("Error: Panel %d object is NULL\n", index);
-        return NULL;
-    }
-    return *panels[index].panel;
-}
-
 void display_init(){
     selected_backend = NULL;
 
@@ -111,244 +49,203 @@ void display_init(){
     if (driver_backends_init_backend(selected_backend) == -1) {
         die("Failed to initialize display backend");
     }
+    startup_mark("display backend");
 
     ui_init();
 }
 
-void set_channel_mapping(int channel, SoundType sound) {
-    if (channel < 0 || channel >= NUM_CHANNELS) {
-        printf("Invalid channel: %d\n", channel);
-        return;
-    }
-    if (sound < 0 || sound >= SOUND_COUNT) {
-        printf("Invalid sound: %d\n", sound);
-        return;
-    }
-    
-    channel_mapping[channel] = sound;
-    printf("Channel %d mapped to %s\n", channel, sound_names[sound]);
-}
-
-void setup_sound_roller(lv_obj_t* roller) {
-    // Create the options string for the roller
-    // LVGL roller expects options separated by '\n'
-    char options[256] = "";
-    
-    for (int i = 0; i < SOUND_COUNT; i++) {
-        strcat(options, sound_names[i]);
-        if (i < SOUND_COUNT - 1) {
-            strcat(options, "\n");
-        }
-    }
-    
-    lv_roller_set_options(roller, options, LV_ROLLER_MODE_NORMAL);
+/* Set by the UI thread once display_init() returns. Until then the
+ * main loop must not touch LVGL */
+static atomic_bool ui_ready;
 
-    lv_roller_set_selected(roller, channel_mapping[current_panel_index], LV_ANIM_OFF);
+static void *display_thread(void *arg) {
+    display_init();
+    startup_mark("ui ready");
+    atomic_store_explicit(&ui_ready, true, memory_order_release);
+    return NULL;
 }
 
-// Function to update the roller when switching channels
-void update_roller_for_channel(lv_obj_t* roller) {
-    lv_roller_set_selected(roller, channel_mapping[current_panel_index], LV_ANIM_OFF);
-}
+int main(){
 
-void set_channel_trigger(lo_address t, int channel, float value) {
-    if (channel < 0 || channel >= NUM_CHANNELS) {
-        printf("Invalid channel: %d\n", channel);
-        return;
-    }
-    SoundType sound = channel_mapping[channel];
-    const char* sound_name = sound_names[sound];
+    startup_mark("main");
 
-    char osc_path[256];
-    snprintf(osc_path, sizeof(osc_path), "/drumkit/%s", sound_name);
-    lo_send(t, osc_path, "f", value);
-}
+    /* Triggers first: the ADC and the OSC output are up before the
+     * display, which is brought up in parallel unless
+     * DRUM_SEQUENTIAL_START is set */
+    bool sequential = getenv("DRUM_SEQUENTIAL_START") != NULL;
+    uint32_t boot_budget_ms = atoi(getenv_default("DRUM_BOOT_BUDGET_MS", "100"));
+    pthread_t ui_thread;
 
+    /* Chips, pads and the panel grid, needed by the scheduler and the UI */
+    topology_init(getenv_default("DRUM_TOPOLOGY", TOPO_DEFAULT_FILE));
+    controller_init();
 
-static int16_t prev_ads_values[6] = {0};
-static bool ads_triggered[6] = {false};
+    if (sequential) {
+        display_init();
+        startup_mark("ui ready");
+        atomic_store(&ui_ready, true);
+    }
 
-void process_ads_triggers(lo_address t, int16_t values[6]) {
-    for (int ads_ch = 0; ads_ch < 6; ads_ch++) {
-        // Obtener el canal Faust correspondiente
-        int faust_ch = 6  - ads_ch;
-        
-        // Saltar si no hay mapeo válido
-        if (faust_ch < 0 || faust_ch >= NUM_CHANNELS) {
-            continue;
+    /* DRUM_ADC=iio leaves the sampling to the kernel ti-ads1015 driver
+     * (triggered buffers), DRUM_ADC=replay runs without the board on the
+     * DRUM_CAPTURE file in DRUM_REPLAY_FILE (or synthetic frames), the
+     * default drives the chips over /dev/i2c-3 */
+    const char *adc = getenv_default("DRUM_ADC", "i2c");
+    bool use_iio = strcmp(adc, "iio") == 0;
+    bool use_replay = strcmp(adc, "replay") == 0;
+    bool use_i2c = !use_iio && !use_replay;
+    if (use_iio) {
+        const char *rate = getenv("DRUM_IIO_RATE");
+        if (ads_iio_init(getenv("DRUM_IIO_DEVICE"),
+                         getenv_default("DRUM_IIO_TRIGGER", ADS_IIO_DEFAULT_TRIGGER),
+                         rate ? atoi(rate) : ADS_IIO_DEFAULT_RATE_HZ) < 0) {
+            return 1;
         }
-        
-        int16_t current_value = values[ads_ch];
-        int16_t prev_value = prev_ads_values[ads_ch];
-        
-        // Detectar rising edge (cruzar el threshold hacia arriba)
-        if (!ads_triggered[ads_ch] && current_value > ADS_THRESHOLD && prev_value <= ADS_THRESHOLD) {
-            // Activar trigger
-            set_channel_trigger(t, faust_ch, 1.0f);
-            ads_triggered[ads_ch] = true;
-            printf("ADS ch%d triggered -> Faust ch%d (value: %d)\n", ads_ch + 1, faust_ch, current_value);
+    } else if (use_replay) {
+        if (ads_replay_init(getenv("DRUM_REPLAY_FILE")) < 0) {
+            return 1;
         }
-        // Detectar falling edge (cruzar el threshold hacia abajo)
-        else if (ads_triggered[ads_ch] && current_value <= ADS_THRESHOLD && prev_value > ADS_THRESHOLD) {
-            // Desactivar trigger
-            set_channel_trigger(t, faust_ch, 0.0f);
-            ads_triggered[ads_ch] = false;
-            printf("ADS ch%d released -> Faust ch%d (value: %d)\n", ads_ch + 1, faust_ch, current_value);
+    } else {
+        int file = ADS1115_init();
+        if(file < 0) {
+            return 1;
         }
-        
-        // Actualizar valor anterior
-        prev_ads_values[ads_ch] = current_value;
+        ads_scheduler_init(file);
     }
-}
-void process_keyev(int file,lo_address t) {
-    struct input_event ie;
-    
-    ssize_t bytes_read = read(file, &ie, sizeof(struct input_event));
-    
-    // Check if we actually read a complete event
-    if (bytes_read != sizeof(struct input_event)) {
-        // No event available or incomplete read - just return
-        return;
-    }
-    
-    if (ie.type == EV_KEY) {
-        if(ie.value == 1){
-            if(current_screen == 0){
-                switch (ie.code) {
-                    case KEY_UP: 
-                        lv_obj_set_style_border_color(get_panel(current_panel_index), lv_color_hex(0x4ADFF3), LV_PART_MAIN | LV_STATE_DEFAULT);
-                        current_panel_index = (current_panel_index-3)+6*(current_panel_index<3);
-                        lv_obj_set_style_border_color(get_panel(current_panel_index), lv_color_black(), LV_PART_MAIN | LV_STATE_DEFAULT);
-                        break;
-                    case KEY_DOWN: 
-                        lv_obj_set_style_border_color(get_panel(current_panel_index), lv_color_hex(0x4ADFF3), LV_PART_MAIN | LV_STATE_DEFAULT);
-                        current_panel_index = (current_panel_index+3)-6*(current_panel_index>=3);
-                        lv_obj_set_style_border_color(get_panel(current_panel_index), lv_color_black(), LV_PART_MAIN | LV_STATE_DEFAULT);
-                        break;
-                    case KEY_LEFT: 
-                        lv_obj_set_style_border_color(get_panel(current_panel_index), lv_color_hex(0x4ADFF3), LV_PART_MAIN | LV_STATE_DEFAULT);
-                        current_panel_index = (current_panel_index-1)+3*(current_panel_index%3==0);
-                        lv_obj_set_style_border_color(get_panel(current_panel_index), lv_color_black(), LV_PART_MAIN | LV_STATE_DEFAULT);
-                        break;
-                    case KEY_RIGHT: 
-                        lv_obj_set_style_border_color(get_panel(current_panel_index), lv_color_hex(0x4ADFF3), LV_PART_MAIN | LV_STATE_DEFAULT);
-                        current_panel_index = (current_panel_index+1)-3*(current_panel_index%3==2);
-                        lv_obj_set_style_border_color(get_panel(current_panel_index), lv_color_black(), LV_PART_MAIN | LV_STATE_DEFAULT);
-                        break;
-                    case KEY_ENTER:
-                        lv_screen_load(ui_Screen2);  
-                        update_roller_for_channel(ui_Roller1);
-                        current_screen = 1;              
-                        break;
-                    case KEY_ESC: 
-                        set_channel_trigger(t,current_panel_index,1);
-                        triggered_channel = current_panel_index;
-                        break;
-                    default:
-                        break;
-                }
-            }else{
-                switch (ie.code) {
-                    case KEY_UP: 
-                        if (channel_mapping[current_panel_index] > 0) {
-                            lv_roller_set_selected(ui_Roller1, channel_mapping[current_panel_index]-1,LV_ANIM_OFF);
-                            set_channel_mapping(current_panel_index, channel_mapping[current_panel_index]-1);
-                        }
-                        break;
-                    case KEY_DOWN: 
-                        if (channel_mapping[current_panel_index] < (SOUND_COUNT-1)) {
-                            lv_roller_set_selected(ui_Roller1, channel_mapping[current_panel_index]+1,LV_ANIM_OFF);
-                            set_channel_mapping(current_panel_index, channel_mapping[current_panel_index]+1);
-                        }
-                        break;
-                    case KEY_LEFT: 
-                        break;
-                    case KEY_RIGHT: 
-                        break;
-                    case KEY_ENTER:
-                        lv_screen_load(ui_Screen1);           
-                        current_screen = 0;     
-                        break;
-                    case KEY_ESC: 
-                        set_channel_trigger(t,current_panel_index,1);
-                        triggered_channel = current_panel_index;
-                        break;
-                    default:
-                        break;
-                }
-            }
+    startup_mark("adc open");
 
-        } else if(ie.value == 0 && ie.code == KEY_ESC){
-            set_channel_trigger(t,triggered_channel,0);
-        }
-    
+    /* DRUM_OUTPUT=midi sends the hits to a rawmidi device instead of the
+     * Faust synth, DRUM_OUTPUT_DEST overrides where (see trigger_out.h) */
+    const char *output = getenv_default("DRUM_OUTPUT", "osc");
+    if (trigger_out_init(output, getenv("DRUM_OUTPUT_DEST")) < 0) {
+        return 1;
     }
-}
+    /* The sequencer is driven over OSC even when the hits go out as MIDI:
+     * DRUM_SYNTH_DEST, else the destination of the OSC output */
+    const char *synth_dest = getenv("DRUM_SYNTH_DEST");
+    if (synth_dest == NULL && strcmp(output, "osc") == 0) {
+        synth_dest = getenv("DRUM_OUTPUT_DEST");
+    }
+    if (synth_control_init(synth_dest) < 0) {
+        return 1;
+    }
+    startup_mark("trigger output");
 
-int main(){
+    /* DRUM_RECORD=<file> appends every hit to a trigger recording, played
+     * back with build/bin/drum_replay (make replay) */
+    const char *record = getenv("DRUM_RECORD");
+    if (record != NULL && recorder_start(record) < 0) {
+        return 1;
+    }
 
-    display_init();
+    /* Per pad thresholds from the last calibration run. DRUM_CALIBRATE
+     * learns them again (pads at rest) and rewrites the file */
+    calibration_init(getenv_default("DRUM_CAL_FILE", CAL_DEFAULT_FILE));
+    /* DRUM_CAPTURE=<file> keeps the last DRUM_CAPTURE_SECONDS of raw ADC
+     * frames in a mapped ring, read out with build/bin/drum_capture_snap */
+    const char *capture = getenv("DRUM_CAPTURE");
+    const char *capture_s = getenv("DRUM_CAPTURE_SECONDS");
+    if (capture != NULL && capture_start(capture, capture_s ? atoi(capture_s) : CAP_DEFAULT_SECONDS) < 0) {
+        return 1;
+    }
+    for (int i = 0; i < topology.num_inputs; i++) {
+        /* Only the i2c backend has auto-range, elsewhere those pads stay at +-6.144 V */
+        uint16_t fsr = topology.inputs[i].fsr_mv;
+        float scale = use_i2c ? ads_scheduler_scale(i) : (float)TOPO_DEFAULT_FSR_MV / (fsr ? fsr : TOPO_DEFAULT_FSR_MV);
+        calibration_set_scale(i, scale);
+        capture_set_scale(i, scale);
+    }
+    if (getenv("DRUM_CALIBRATE") != NULL) {
+        uint32_t pads = 0;
+        for (int i = 0; i < topology.num_inputs; i++) {
+            if (topology.inputs[i].channel != TOPO_POT) pads |= 1u << i;
+        }
+        calibration_start(pads);
+    }
 
-    int fADC = ADS1115_init(0);
-    if(fADC< 0) return 1;
+    if (!sequential && pthread_create(&ui_thread, NULL, display_thread, NULL) != 0) {
+        die("Failed to start the UI thread\n");
+    }
 
     int fEv = open("/dev/input/event3", O_RDONLY|O_NONBLOCK);
     if (fEv == -1) {
         perror("Opening /dev/input/event3");
         return EXIT_FAILURE;
     }
-    
-    lo_address t = lo_address_new("localhost", "5510");
-
-    int channel = 0;
-
-    int level;
-    int16_t value;
-    uint32_t idle_time;
-
-    lv_obj_set_style_border_color(get_panel(0),lv_color_black(),LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    setup_sound_roller(ui_Roller1);
-    set_channel_mapping(0,SOUND_HIGH_TOM);
-
-    int file = ADS1115_init();
+    startup_mark("evdev open");
 
-    if(file < 0) {
-        return 1;
-    }
+    bool ui_started = false;
+    bool first_frame = true;
 
     int s = 0;
-    int16_t values[6];
+    int16_t values[ADS_MAX_INPUTS] = {0};
+    uint32_t input_counts[ADS_MAX_INPUTS];
 
     struct timeval start_time, current_time;
     gettimeofday(&start_time, NULL);
     
     int volume = 100;
 
+    /* The only wait of the loop is in the ADC frame: the scheduler sleeps
+     * until the next chip is due (iio until the next scan, replay until
+     * the next frame time). LVGL runs the timers that are due in between
+     * and never sets the pace, the bus does not sit idle for the display */
     while (true) {
-        /* Returns the time to the next timer execution */
-        idle_time = lv_timer_handler();
-
-        s++;
+        if (!ui_started && atomic_load_explicit(&ui_ready, memory_order_acquire)) {
+            if (!sequential) {
+                pthread_join(ui_thread, NULL);
+            }
+            select_panel(0);
+            setup_sound_roller(ui_Roller1);
+            setup_seq_screen();
+            ui_started = true;
+            if (!first_frame) {
+                startup_report(boot_budget_ms);
+            }
+        }
 
-        for(int i = 0; i < 3; i++){
-            ADS1115_start_reading(i, file);
-            ADS1115_start_reading(i+4, file);
-            values[i] = ADS1115_get_result(i+1, file);
-            values[i+3] = ADS1115_get_result(i+5, file);
+        if (ui_started) {
+            lv_timer_handler();
         }
 
-        process_ads_triggers(t, values);
+        /* All chips stay busy across frames. Only inputs with a real new
+         * sample are in fresh, errors go to ads_scheduler_take_errors.
+         * iio scans that queued up meanwhile are all processed here, in
+         * order, the last one leaves its values for the pot */
+        int fresh;
+        do {
+            s++;
+            fresh = use_iio ? ads_iio_frame(values) : use_replay ? ads_replay_frame(values) : ads_scheduler_frame(values);
+            if (fresh < 0) {
+                fresh = 0;
+            }
+            if (use_i2c) {
+                rescale_ads_inputs(ads_scheduler_take_rescaled());
+            }
+            uint32_t hits = process_ads_triggers(values, fresh);
+            capture_frame(values, fresh, hits);
+        } while (use_iio && ads_iio_queued());
+
+        if (first_frame) {
+            startup_mark("first frame");
+            first_frame = false;
+            if (ui_started) {
+                startup_report(boot_budget_ms);
+            }
+        }
 
-        int vpot= 100-(ADS1115_read(channel,fADC)/259);
-        if (vpot < (volume - 1)||vpot > (volume+1))
-            volume = vpot;
+        /* The pot is sampled at ADS_POT_RATE_HZ, 259 counts per step at +-6.144 V */
+        if (topology.pot_input >= 0 && (fresh & (1 << topology.pot_input))) {
+            int32_t pot = (int32_t)values[topology.pot_input] * topology.inputs[topology.pot_input].fsr_mv / TOPO_DEFAULT_FSR_MV;
+            int vpot= 100-(pot/259);
+            if (vpot < (volume - 1)||vpot > (volume+1))
+                volume = vpot;
+        }
+        if (ui_started) {
             lv_slider_set_value(ui_Volume,volume,LV_ANIM_OFF);
-
-        process_keyev(fEv,t);
-
-        if (idle_time > 1000) {  // Sanity check
-            idle_time = 30;
+            process_keyev(fEv);
+            /* Parameter and tempo changes of this frame, one message per control */
+            synth_control_flush();
         }
 
         gettimeofday(&current_time, NULL);
@@ -357,12 +254,35 @@ int main(){
         
         if(elapsed_us >= 1000000) {
             float elapsed_seconds = elapsed_us / 1000000.0f;
-            printf("%.1f SPS\n", s / elapsed_seconds);
+            if (use_iio) {
+                ads_iio_take_counts(input_counts);
+            } else if (use_replay) {
+                ads_replay_take_counts(input_counts);
+            } else {
+                ads_scheduler_take_counts(input_counts);
+            }
+
+            /* Achieved rate of every input */
+            char rates[192];
+            int len = 0;
+            uint32_t total = 0;
+            for (int i = 0; i < topology.num_inputs; i++) {
+                total += input_counts[i];
+                len += snprintf(rates + len, sizeof(rates) - len, " %d:%.0f", i, (double)(input_counts[i] / elapsed_seconds));
+            }
+            printf("%.1f SPS, %.0f samples/s, per input:%s\n", (double)(s / elapsed_seconds),
+                   (double)(total / elapsed_seconds), rates);
+            if (use_i2c) {
+                AdsErrors errors;
+                ads_scheduler_take_errors(&errors);
+                if (errors.bus_errors || errors.timeouts || errors.recoveries || errors.offline) {
+                    printf("ADC errors: %u bus, %u timeouts, %u recoveries, offline inputs 0x%x\n",
+                           errors.bus_errors, errors.timeouts, errors.recoveries, errors.offline);
+                }
+            }
             s = 0;
             start_time = current_time;
         }
-
-        usleep(idle_time * 1000);
     }
     return 0;
 }
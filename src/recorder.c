@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "recorder.h"
+
+// A hit as the trigger path leaves it, the writer makes the record
+typedef struct {
+    uint64_t t_ns;
+    uint8_t pad;
+    uint8_t sound;
+    uint8_t velocity;
+    uint8_t flags;
+} RecHit;
+
+// Single producer (the acquisition loop), single consumer (the writer)
+static RecHit ring[REC_RING_SIZE];
+static atomic_uint ring_head;   // written by the trigger path
+static atomic_uint ring_tail;   // written by the writer
+static atomic_uint dropped;     // hits that found the ring full
+
+static bool recording;
+static atomic_bool stopping;
+static pthread_t writer;
+static int rec_fd = -1;
+
+// Trigger path frame state
+static bool frame_open;
+static uint64_t frame_ns;
+
+// Writer state: time of the last record, records not yet written
+static uint64_t last_ns;
+static RecEvent out_buf[REC_RING_SIZE / 4];
+static int out_len;
+static bool write_failed;   // the ring is still drained, into nothing
+
+// vDSO on Linux, no syscall
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void push(const RecHit *hit) {
+    unsigned head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&ring_tail, memory_order_acquire) >= REC_RING_SIZE) {
+        atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+        return;
+    }
+    ring[head % REC_RING_SIZE] = *hit;
+    atomic_store_explicit(&ring_head, head + 1, memory_order_release);
+}
+
+void recorder_hit(int pad, int sound, float velocity) {
+    if (!recording) return;
+
+    RecHit hit = {
+        .pad = pad,
+        .sound = sound,
+        .velocity = (uint8_t)(velocity * 255.0f + 0.5f),
+        .flags = frame_open ? REC_FLAG_FRAME : 0,
+    };
+    if (!frame_open) {
+        frame_ns = now_ns();
+        frame_open = true;
+    }
+    hit.t_ns = frame_ns;
+    push(&hit);
+}
+
+void recorder_frame_end(void) {
+    frame_open = false;
+}
+
+static void flush_records(void) {
+    size_t len = out_len * sizeof(RecEvent);
+    const uint8_t *p = (const uint8_t *)out_buf;
+    out_len = 0;
+    while (len > 0 && !write_failed) {
+        ssize_t n = write(rec_fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            printf("Recorder: write failed, no more hits recorded: %s\n", strerror(errno));
+            write_failed = true;
+            return;
+        }
+        p += n;
+        len -= n;
+    }
+}
+
+static void add_record(const RecEvent *ev) {
+    out_buf[out_len++] = *ev;
+    if (out_len == (int)(sizeof(out_buf) / sizeof(out_buf[0]))) {
+        flush_records();
+    }
+}
+
+// Ring to records: absolute times become deltas, a delta past 71 minutes
+// is carried by gap records
+static void drain(void) {
+    unsigned tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&ring_head, memory_order_acquire);
+
+    for (; tail != head; tail++) {
+        const RecHit *hit = &ring[tail % REC_RING_SIZE];
+        uint64_t delta_us = hit->t_ns > last_ns ? (hit->t_ns - last_ns) / 1000 : 0;
+
+        while (delta_us > UINT32_MAX) {
+            RecEvent gap = {UINT32_MAX, REC_PAD_NONE, 0, 0, REC_FLAG_GAP};
+            add_record(&gap);
+            delta_us -= UINT32_MAX;
+            last_ns += UINT32_MAX * 1000ull;
+        }
+        RecEvent ev = {(uint32_t)delta_us, hit->pad, hit->sound, hit->velocity, hit->flags};
+        add_record(&ev);
+        // Keep the sub-microsecond rest, no drift over a long take
+        last_ns += delta_us * 1000;
+    }
+    atomic_store_explicit(&ring_tail, tail, memory_order_release);
+
+    if (out_len > 0) flush_records();
+
+    unsigned d = atomic_exchange_explicit(&dropped, 0, memory_order_relaxed);
+    if (d > 0) printf("Recorder: ring full, %u hits not recorded\n", d);
+}
+
+static void *writer_thread(void *arg) {
+    const struct timespec period = {0, REC_WRITE_MS * 1000000L};
+    while (!atomic_load(&stopping)) {
+        nanosleep(&period, NULL);
+        drain();
+    }
+    return NULL;
+}
+
+// New file: write the header. Existing one: check it is a recording
+static int check_header(int fd, const char *path) {
+    struct stat st;
+    RecHeader header;
+
+    if (fstat(fd, &st) < 0) {
+        perror(path);
+        return -1;
+    }
+    if (st.st_size == 0) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, REC_MAGIC, sizeof(REC_MAGIC));
+        header.version = REC_VERSION;
+        header.event_size = sizeof(RecEvent);
+        if (write(fd, &header, sizeof(header)) != sizeof(header)) {
+            perror(path);
+            return -1;
+        }
+        return 0;
+    }
+    if (pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+        memcmp(header.magic, REC_MAGIC, sizeof(REC_MAGIC)) != 0 ||
+        header.version != REC_VERSION || header.event_size != sizeof(RecEvent)) {
+        printf("%s is not a version %d trigger recording\n", path, REC_VERSION);
+        return -1;
+    }
+    // A record cut by a kill in the middle of a write would shift the new session
+    off_t cut = (st.st_size - sizeof(header)) % sizeof(RecEvent);
+    if (cut != 0 && ftruncate(fd, st.st_size - cut) < 0) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+int recorder_start(const char *path) {
+    rec_fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (rec_fd < 0) {
+        perror(path);
+        return -1;
+    }
+    if (check_header(rec_fd, path) < 0) {
+        close(rec_fd);
+        rec_fd = -1;
+        return -1;
+    }
+
+    // The session record is the time base of the hits after it
+    last_ns = now_ns();
+    RecHit session = {last_ns, REC_PAD_NONE, 0, 0, REC_FLAG_SESSION};
+    push(&session);
+
+    write_failed = false;
+    atomic_store(&stopping, false);
+    if (pthread_create(&writer, NULL, writer_thread, NULL) != 0) {
+        printf("Recorder: can not start the writer thread\n");
+        close(rec_fd);
+        rec_fd = -1;
+        return -1;
+    }
+    recording = true;
+    printf("Recording triggers to %s\n", path);
+    return 0;
+}
+
+void recorder_stop(void) {
+    if (!recording) return;
+    recording = false;
+
+    atomic_store(&stopping, true);
+    pthread_join(writer, NULL);
+    drain();
+    close(rec_fd);
+    rec_fd = -1;
+}
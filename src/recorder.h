@@ -0,0 +1,71 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stdint.h>
+
+// Trigger recording: every hit the controller sends (pad, sound,
+// velocity, monotonic time) appended to a binary file, played back by
+// tools/replay.c (make replay). The trigger path only stores the hit in
+// a ring, a background thread turns it into records and writes them, so
+// a slow SD card never holds up the acquisition loop.
+//
+// File: a RecHeader, then RecEvent records, little-endian (the board's
+// order). Opening an existing file appends a new session to it. The app
+// is stopped by a signal, the hits of its last REC_WRITE_MS can be missing.
+
+#define REC_MAGIC       "DRUMREC"
+#define REC_VERSION     1
+
+// Hits the ring holds until the writer catches up, a power of two
+#define REC_RING_SIZE   4096
+// How often the writer wakes up to drain the ring
+#define REC_WRITE_MS    50
+
+// pad of a D-pad (ESC) hit, and of a record that carries no hit
+#define REC_PAD_KEY     0xFE
+#define REC_PAD_NONE    0xFF
+
+// Hit controls of drumkit.dsp tools/replay.c plays on, + the sound name.
+// Its own, like the sequencer's (SEQ_HIT_PREFIX): a replay runs along with
+// the pads, each control has a single writer
+#define REC_HIT_PREFIX  "/drumkit/Replay/"
+
+// Record flags
+#define REC_FLAG_SESSION 0x01   // a recording starts here, no hit
+#define REC_FLAG_FRAME   0x02   // sent in the same frame as the previous hit
+#define REC_FLAG_GAP     0x04   // only time, delta_us ran out, no hit
+
+typedef struct {
+    char magic[8];          // REC_MAGIC
+    uint32_t version;       // REC_VERSION
+    uint32_t event_size;    // sizeof(RecEvent)
+} RecHeader;
+
+typedef struct {
+    uint32_t delta_us;      // since the previous record
+    uint8_t pad;            // topology input, REC_PAD_KEY or REC_PAD_NONE
+    uint8_t sound;          // SoundType
+    uint8_t velocity;       // 0-255 for 0-1
+    uint8_t flags;
+} RecEvent;
+
+// Also read by the C++ tools in synth/
+#ifdef __cplusplus
+static_assert(sizeof(RecEvent) == 8, "records are 8 bytes");
+#else
+_Static_assert(sizeof(RecEvent) == 8, "records are 8 bytes");
+#endif
+
+// Opens (or creates) path and starts the writer thread. -1 if the file
+// can not be opened or is not a recording, nothing is recorded then
+int recorder_start(const char *path);
+// Writes what is left in the ring and closes the file
+void recorder_stop(void);
+
+// Trigger path, no-ops while not recording. recorder_hit takes the time of
+// the first hit of a frame for all of them, recorder_frame_end closes the
+// frame (called with trigger_out_flush)
+void recorder_hit(int pad, int sound, float velocity);
+void recorder_frame_end(void);
+
+#endif
@@ -0,0 +1,38 @@
+#include <stddef.h>
+
+#include "seq_patterns.h"
+
+const char *seq_pattern_names[SEQ_NUM_PATTERNS] = {
+    "Click",
+    "Rock",
+    "Funk",
+    "Disco",
+    "Half time",
+};
+
+// Kick, Snare, Hihat, OpenHihat, BassTom, MedTom, HighTom, Crash
+const char *seq_pattern_grids[SEQ_NUM_PATTERNS][SOUND_COUNT] = {
+    {NULL},
+    {
+        "X.......X.x.....",
+        "....X.......X...",
+        "X.x.X.x.X.x.X.x.",
+    },
+    {
+        "X..x..X...X..x..",
+        "....X..x.x..X...",
+        "XxxxXxxxXxxxXxx.",
+        "...............x",
+    },
+    {
+        "X...X...X...X...",
+        "....X.......X...",
+        "x...x...x...x...",
+        "..X...X...X...X.",
+    },
+    {
+        "X.........x.....",
+        "........X.......",
+        "X.x.x.x.X.x.x.x.",
+    },
+};
@@ -0,0 +1,40 @@
+#ifndef SEQ_PATTERNS_H
+#define SEQ_PATTERNS_H
+
+#include "sounds.h"
+
+// Backing patterns of the sequencer in the synth (synth/sequencer.h),
+// one bar of 4/4 in sixteenths. Shared with the controller, which only
+// shows the names and sends the pattern number
+
+#define SEQ_STEPS           16
+#define SEQ_STEPS_PER_BEAT  4
+#define SEQ_NUM_PATTERNS    5
+
+#define SEQ_MIN_BPM         40
+#define SEQ_MAX_BPM         240
+#define SEQ_DEFAULT_BPM     100
+
+// OSC paths of the sequencer, arguments in synth/sequencer.h
+#define SEQ_PATH_RUN        "/seq/run"
+#define SEQ_PATH_PATTERN    "/seq/pattern"
+#define SEQ_PATH_TEMPO      "/seq/tempo"
+#define SEQ_PATH_MAP        "/seq/map"
+#define SEQ_PATH_CLICK      "/seq/click"
+// Hit controls of the steps in drumkit.dsp, + the sound name. The pads
+// (/drumkit/<Sound>) and a replay (REC_HIT_PREFIX) have their own, each
+// control has a single writer
+#define SEQ_HIT_PREFIX      "/drumkit/Seq/"
+
+// Velocity of an accented ('X') and a normal ('x') step
+#define SEQ_ACCENT_VELOCITY 1.0f
+#define SEQ_VELOCITY        0.6f
+
+// Pattern 0 is the click alone
+extern const char *seq_pattern_names[SEQ_NUM_PATTERNS];
+
+// SEQ_STEPS characters per sound, in SoundType order: 'X' accent, 'x'
+// normal, anything else a rest. NULL for a sound the pattern never plays
+extern const char *seq_pattern_grids[SEQ_NUM_PATTERNS][SOUND_COUNT];
+
+#endif
@@ -0,0 +1,36 @@
+#include "sound_params.h"
+
+const SoundParam sound_params[] = {
+    {SOUND_KICK, "Tune", "Hz", 40, 25, 80, 1, 0},
+    {SOUND_KICK, "Decay", "s", 0.7f, 0.1f, 2, 0.02f, 2},
+    {SOUND_KICK, "Tone", "Hz", 150, 60, 600, 10, 0},
+    {SOUND_SNARE, "Tune", "Hz", 220, 120, 400, 4, 0},
+    {SOUND_SNARE, "Decay", "s", 0.15f, 0.05f, 0.6f, 0.01f, 2},
+    {SOUND_SNARE, "Snappy", "s", 0.12f, 0.03f, 0.5f, 0.01f, 2},
+    {SOUND_HIHAT, "Decay", "s", 0.08f, 0.02f, 0.4f, 0.01f, 2},
+    {SOUND_HIHAT, "Tone", "Hz", 8000, 3000, 12000, 100, 0},
+    {SOUND_OPEN_HIHAT, "Decay", "s", 0.5f, 0.1f, 2, 0.02f, 2},
+    {SOUND_OPEN_HIHAT, "Tone", "Hz", 6000, 2000, 12000, 100, 0},
+    {SOUND_BASS_TOM, "Tune", "Hz", 85, 50, 150, 1, 0},
+    {SOUND_BASS_TOM, "Decay", "s", 0.8f, 0.1f, 2, 0.02f, 2},
+    {SOUND_MED_TOM, "Tune", "Hz", 130, 80, 220, 2, 0},
+    {SOUND_MED_TOM, "Decay", "s", 0.6f, 0.1f, 2, 0.02f, 2},
+    {SOUND_HIGH_TOM, "Tune", "Hz", 200, 120, 350, 2, 0},
+    {SOUND_HIGH_TOM, "Decay", "s", 0.4f, 0.1f, 1.5f, 0.02f, 2},
+    {SOUND_CRASH, "Decay", "s", 1, 0.3f, 4, 0.05f, 2},
+    {SOUND_CRASH, "Tone", "Hz", 3000, 1000, 8000, 100, 0},
+};
+
+_Static_assert(sizeof(sound_params) / sizeof(sound_params[0]) == SOUND_PARAM_COUNT, "SOUND_PARAM_COUNT");
+
+int sound_params_of(SoundType sound, int *count) {
+    int first = -1;
+    *count = 0;
+    for (int i = 0; i < SOUND_PARAM_COUNT; i++) {
+        if (sound_params[i].sound == sound) {
+            if (first < 0) first = i;
+            (*count)++;
+        }
+    }
+    return first;
+}
@@ -0,0 +1,28 @@
+#ifndef SOUND_PARAMS_H
+#define SOUND_PARAMS_H
+
+#include "sounds.h"
+
+// The editable parameters of the drumkit.dsp sounds, same labels, ranges
+// and defaults as the param() sliders there. OSC path /drumkit/<Sound>/<name>
+
+#define SOUND_PARAM_COUNT   18
+// Most parameters one sound has, the rows of the edit screen
+#define SOUND_PARAMS_MAX    3
+
+typedef struct {
+    SoundType sound;
+    const char *name;
+    const char *unit;
+    float init, min, max;
+    float step;         // of one key press
+    int decimals;       // shown
+} SoundParam;
+
+// Grouped by sound
+extern const SoundParam sound_params[SOUND_PARAM_COUNT];
+
+// Index of the first parameter of sound in sound_params and how many it has
+int sound_params_of(SoundType sound, int *count);
+
+#endif
@@ -0,0 +1,12 @@
+#include "sounds.h"
+
+const char* sound_names[SOUND_COUNT] = {
+    "Kick",
+    "Snare", 
+    "Hihat",
+    "OpenHihat",
+    "BassTom",
+    "MedTom",
+    "HighTom",
+    "Crash"
+};
@@ -0,0 +1,33 @@
+#ifndef SOUNDS_H
+#define SOUNDS_H
+
+// The drumkit.dsp sounds, shared by the controller, the trigger outputs
+// and the tools that link those without the UI
+typedef enum {
+    SOUND_KICK = 0,
+    SOUND_SNARE,
+    SOUND_HIHAT,
+    SOUND_OPEN_HIHAT,
+    SOUND_BASS_TOM,
+    SOUND_MED_TOM,
+    SOUND_HIGH_TOM,
+    SOUND_CRASH,
+    SOUND_COUNT  // Total number of sounds
+} SoundType;
+
+// Sound names for OSC paths and display
+extern const char* sound_names[SOUND_COUNT];
+
+// Value written to a hit control of drumkit.dsp (hit()): twice a count of
+// the writer's hits of that sound, modulo HIT_COUNTS, plus the velocity
+// 0-1. A hit never writes the value the control already holds, whatever
+// the velocity, so two hits in one audio block both change it. A writer
+// starts its count anywhere: another process, or the same one restarted,
+// only repeats the last value if it lands on the same count too
+#define HIT_COUNTS 1024
+
+static inline float sound_hit_value(unsigned count, float velocity) {
+    return 2.0f * (float)(count % HIT_COUNTS) + velocity;
+}
+
+#endif
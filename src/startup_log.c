@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#include "startup_log.h"
+
+#define STARTUP_MAX_MARKS 16
+
+typedef struct {
+    const char *event;
+    struct timespec ts;
+} StartupMark;
+
+static StartupMark marks[STARTUP_MAX_MARKS];
+static atomic_uint num_marks;
+
+static double ts_ms(const struct timespec *ts) {
+    return ts->tv_sec * 1000.0 + ts->tv_nsec / 1000000.0;
+}
+
+void startup_mark(const char *event) {
+    unsigned int i = atomic_fetch_add(&num_marks, 1);
+    if (i >= STARTUP_MAX_MARKS) {
+        return;
+    }
+    // CLOCK_BOOTTIME so the first mark also tells how long after kernel start main() ran
+    clock_gettime(CLOCK_BOOTTIME, &marks[i].ts);
+    marks[i].event = event;
+}
+
+void startup_report(uint32_t budget_ms) {
+    unsigned int n = atomic_load(&num_marks);
+    if (n > STARTUP_MAX_MARKS) n = STARTUP_MAX_MARKS;
+    if (n == 0) return;
+
+    // Marks from the UI thread can land out of order, sort by time
+    for (unsigned int i = 1; i < n; i++) {
+        StartupMark m = marks[i];
+        unsigned int j = i;
+        while (j > 0 && ts_ms(&marks[j - 1].ts) > ts_ms(&m.ts)) {
+            marks[j] = marks[j - 1];
+            j--;
+        }
+        marks[j] = m;
+    }
+
+    double t0 = ts_ms(&marks[0].ts);
+    double first_hit = -1;
+
+    printf("Startup timeline (boot +%.3f s):\n", t0 / 1000.0);
+    for (unsigned int i = 0; i < n; i++) {
+        double t = ts_ms(&marks[i].ts) - t0;
+        printf("  %8.2f ms  %s\n", t, marks[i].event);
+        if (first_hit < 0 && strcmp(marks[i].event, "first frame") == 0) {
+            first_hit = t;
+        }
+    }
+
+    if (first_hit < 0) {
+        printf("Time to first playable hit: not reached\n");
+    } else if (first_hit > budget_ms) {
+        printf("Time to first playable hit: %.2f ms, OVER the %u ms budget\n", first_hit, budget_ms);
+    } else {
+        printf("Time to first playable hit: %.2f ms (budget %u ms)\n", first_hit, budget_ms);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef STARTUP_LOG_H
+#define STARTUP_LOG_H
+
+#include <stdint.h>
+
+// Records a named point of the startup timeline, safe to call from any thread
+void startup_mark(const char *event);
+
+// Prints the timeline relative to the first mark and checks the
+// time-to-first-playable-hit ("first frame" mark) against budget_ms
+void startup_report(uint32_t budget_ms);
+
+#endif
@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "synth_control.h"
+
+static lo_address synth_addr;
+
+typedef struct {
+    const char *path;
+    float value;
+} PendingSet;
+static PendingSet pending[SYNTH_CONTROL_MAX_PENDING];
+static int num_pending;
+
+lo_address synth_address_new(const char *dest) {
+    char host[64];
+
+    if (dest == NULL) {
+        dest = SYNTH_DEFAULT_DEST;
+    }
+    const char *colon = strrchr(dest, ':');
+    if (colon == NULL || colon == dest || (size_t)(colon - dest) >= sizeof(host)) {
+        printf("OSC destination must be host:port, not %s\n", dest);
+        return NULL;
+    }
+    memcpy(host, dest, colon - dest);
+    host[colon - dest] = '\0';
+    return lo_address_new(host, colon + 1);
+}
+
+int synth_control_init(const char *dest) {
+    synth_addr = synth_address_new(dest);
+    return synth_addr != NULL ? 0 : -1;
+}
+
+void synth_control_int(const char *path, int value) {
+    if (synth_addr != NULL && lo_send(synth_addr, path, "i", value) < 0) {
+        printf("OSC: %s not sent: %s\n", path, lo_address_errstr(synth_addr));
+    }
+}
+
+void synth_control_float(const char *path, float value) {
+    if (synth_addr != NULL && lo_send(synth_addr, path, "f", (double)value) < 0) {
+        printf("OSC: %s not sent: %s\n", path, lo_address_errstr(synth_addr));
+    }
+}
+
+void synth_control_set(const char *path, float value) {
+    for (int i = 0; i < num_pending; i++) {
+        if (strcmp(pending[i].path, path) == 0) {
+            pending[i].value = value;
+            return;
+        }
+    }
+    if (num_pending == SYNTH_CONTROL_MAX_PENDING) {
+        // Full: send what is held and start over
+        synth_control_flush();
+    }
+    pending[num_pending].path = path;
+    pending[num_pending].value = value;
+    num_pending++;
+}
+
+void synth_control_flush(void) {
+    if (num_pending == 0 || synth_addr == NULL) {
+        num_pending = 0;
+        return;
+    }
+    if (num_pending == 1) {
+        synth_control_float(pending[0].path, pending[0].value);
+    } else {
+        lo_bundle bundle = lo_bundle_new(LO_TT_IMMEDIATE);
+        for (int i = 0; i < num_pending; i++) {
+            lo_message msg = lo_message_new();
+            lo_message_add_float(msg, pending[i].value);
+            lo_bundle_add_message(bundle, pending[i].path, msg);
+        }
+        if (lo_send_bundle(synth_addr, bundle) < 0) {
+            printf("OSC: bundle of %d controls not sent: %s\n", num_pending, lo_address_errstr(synth_addr));
+        }
+        lo_bundle_free_recursive(bundle);
+    }
+    num_pending = 0;
+}
@@ -0,0 +1,32 @@
+#ifndef SYNTH_CONTROL_H
+#define SYNTH_CONTROL_H
+
+#include <lo/lo.h>
+
+#define SYNTH_DEFAULT_DEST "localhost:5510"
+
+// Distinct paths synth_control_set holds between two flushes
+#define SYNTH_CONTROL_MAX_PENDING 32
+
+// Address of a synth OSC port, dest "host:port" or NULL for
+// SYNTH_DEFAULT_DEST. NULL (and a message) if dest is not host:port
+lo_address synth_address_new(const char *dest);
+
+// Control of the Faust synth besides the hits (the sequencer of
+// synth/sequencer.h, the sound parameters), so it reaches the synth
+// whatever the trigger output is. Called from the main loop thread only
+int synth_control_init(const char *dest);
+
+// Sent right away
+void synth_control_int(const char *path, int value);
+void synth_control_float(const char *path, float value);
+
+// Continuous controls (a held key sweeping a value): only the last value
+// of every path is kept until synth_control_flush. path must stay valid
+// until then
+void synth_control_set(const char *path, float value);
+// Once per UI frame: the held values leave in one bundle, at most one
+// message per path however many changes the frame had
+void synth_control_flush(void);
+
+#endif
@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "topology.h"
+#include "sounds.h"
+#include "ads1115_reader.h"
+
+// The board as built: pot on AIN0 of 0x48, the pads on the other wired
+// inputs, in reverse channel order (the old faust_ch = 6 - ads_ch)
+static const Topology topology_default = {
+    .num_inputs = 6,
+    .inputs = {
+        {0x48, 0, TOPO_POT, TOPO_DEFAULT_FSR_MV, TOPO_DEFAULT_SPS},
+        {0x48, 1, 5, TOPO_DEFAULT_FSR_MV, TOPO_DEFAULT_SPS},
+        {0x48, 2, 4, TOPO_DEFAULT_FSR_MV, TOPO_DEFAULT_SPS},
+        {0x49, 0, 3, TOPO_DEFAULT_FSR_MV, TOPO_DEFAULT_SPS},
+        {0x49, 1, 2, TOPO_DEFAULT_FSR_MV, TOPO_DEFAULT_SPS},
+        {0x49, 2, 1, TOPO_DEFAULT_FSR_MV, TOPO_DEFAULT_SPS},
+    },
+    .num_channels = 6,
+    .channels = {
+        {SOUND_HIGH_TOM,   0, 0},
+        {SOUND_SNARE,      1, 0},
+        {SOUND_HIHAT,      2, 0},
+        {SOUND_OPEN_HIHAT, 0, 1},
+        {SOUND_BASS_TOM,   1, 1},
+        {SOUND_CRASH,      2, 1},
+    },
+    .cols = 3,
+    .rows = 2,
+    .pot_input = 0,
+};
+
+Topology topology = topology_default;
+
+static int parse_sound(const char *name) {
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        if (strcasecmp(name, sound_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// gain=<mV>|auto and sps=<rate> after the channel of an input line
+static int parse_options(TopoInput *in, const char *path, int lineno, const char *opts) {
+    char opt[16];
+    int n;
+
+    while (sscanf(opts, "%15s%n", opt, &n) == 1) {
+        opts += n;
+        if (opt[0] == '#') break;
+
+        char *end;
+        if (strncmp(opt, "gain=", 5) == 0) {
+            if (strcmp(opt + 5, "auto") == 0) {
+                in->fsr_mv = TOPO_GAIN_AUTO;
+                continue;
+            }
+            long mv = strtol(opt + 5, &end, 10);
+            int pga = 0;
+            while (pga < ADS1115_NUM_PGA && ADS1115_fsr_mv[pga] != mv) pga++;
+            if (*end != '\0' || pga == ADS1115_NUM_PGA) {
+                printf("%s:%d: gain must be 6144, 4096, 2048, 1024, 512, 256 or auto\n", path, lineno);
+                return -1;
+            }
+            in->fsr_mv = mv;
+        } else if (strncmp(opt, "sps=", 4) == 0) {
+            long sps = strtol(opt + 4, &end, 10);
+            if (*end != '\0' || ADS1115_dr_code(sps) < 0) {
+                printf("%s:%d: sps must be 8, 16, 32, 64, 128, 250, 475 or 860\n", path, lineno);
+                return -1;
+            }
+            in->sps = sps;
+        } else {
+            printf("%s:%d: unknown option %s\n", path, lineno, opt);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// One line of the file into topo, -1 with the reason printed
+static int parse_line(Topology *topo, const char *path, int lineno, const char *line) {
+    char kind[16], arg[16];
+    int a, b, c;
+    char *end;
+
+    if (sscanf(line, "%15s", kind) != 1 || kind[0] == '#') return 0;
+
+    if (strcmp(kind, "input") == 0) {
+        char addr_str[16];
+        int n = 0;
+        if (sscanf(line, "%*s %15s %d %15s%n", addr_str, &b, arg, &n) != 3) goto bad;
+        a = strtol(addr_str, &end, 0);
+        if (*end != '\0' || a < TOPO_FIRST_ADDR || a >= TOPO_FIRST_ADDR + TOPO_MAX_CHIPS) {
+            printf("%s:%d: address must be 0x%02x-0x%02x\n", path, lineno,
+                   TOPO_FIRST_ADDR, TOPO_FIRST_ADDR + TOPO_MAX_CHIPS - 1);
+            return -1;
+        }
+        if (b < 0 || b >= TOPO_CHIP_INPUTS) {
+            printf("%s:%d: ain must be 0-%d\n", path, lineno, TOPO_CHIP_INPUTS - 1);
+            return -1;
+        }
+        if (strcmp(arg, "pot") == 0) {
+            c = TOPO_POT;
+        } else {
+            c = strtol(arg, &end, 10);
+            if (*end != '\0' || c < 0 || c >= TOPO_MAX_CHANNELS) {
+                printf("%s:%d: channel must be 0-%d or pot\n", path, lineno, TOPO_MAX_CHANNELS - 1);
+                return -1;
+            }
+        }
+        for (int i = 0; i < topo->num_inputs; i++) {
+            if (topo->inputs[i].addr == a && topo->inputs[i].ain == b) {
+                printf("%s:%d: 0x%02x AIN%d listed twice\n", path, lineno, a, b);
+                return -1;
+            }
+        }
+        if (c == TOPO_POT) {
+            if (topo->pot_input >= 0) {
+                printf("%s:%d: only one pot\n", path, lineno);
+                return -1;
+            }
+            topo->pot_input = topo->num_inputs;
+        }
+        TopoInput in = {a, b, c, TOPO_DEFAULT_FSR_MV, TOPO_DEFAULT_SPS};
+        if (parse_options(&in, path, lineno, line + n) < 0) return -1;
+        if (c == TOPO_POT && in.fsr_mv == TOPO_GAIN_AUTO) {
+            printf("%s:%d: the pot needs a fixed gain\n", path, lineno);
+            return -1;
+        }
+        // At most TOPO_MAX_INPUTS distinct (addr, ain) pairs, no room check needed
+        topo->inputs[topo->num_inputs++] = in;
+        return 0;
+    }
+
+    if (strcmp(kind, "channel") == 0) {
+        if (sscanf(line, "%*s %d %15s %d %d", &a, arg, &b, &c) != 4) goto bad;
+        if (a != topo->num_channels || a >= TOPO_MAX_CHANNELS) {
+            printf("%s:%d: channels must be listed in order, expected %d\n", path, lineno, topo->num_channels);
+            return -1;
+        }
+        int sound = parse_sound(arg);
+        if (sound < 0) {
+            printf("%s:%d: unknown sound %s\n", path, lineno, arg);
+            return -1;
+        }
+        if (b < 0 || b >= TOPO_MAX_GRID || c < 0 || c >= TOPO_MAX_GRID) {
+            printf("%s:%d: grid cell must be within %dx%d\n", path, lineno, TOPO_MAX_GRID, TOPO_MAX_GRID);
+            return -1;
+        }
+        for (int i = 0; i < topo->num_channels; i++) {
+            if (topo->channels[i].col == b && topo->channels[i].row == c) {
+                printf("%s:%d: cell %d %d taken by channel %d\n", path, lineno, b, c, i);
+                return -1;
+            }
+        }
+        topo->channels[topo->num_channels++] = (TopoChannel){sound, b, c};
+        if (b >= topo->cols) topo->cols = b + 1;
+        if (c >= topo->rows) topo->rows = c + 1;
+        return 0;
+    }
+
+bad:
+    printf("%s:%d: bad line: %s", path, lineno, line);
+    return -1;
+}
+
+int topology_init(const char *path) {
+    topology = topology_default;
+
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        printf("No topology file %s, using the built-in wiring\n", path);
+        return -1;
+    }
+
+    Topology topo;
+    memset(&topo, 0, sizeof(topo));
+    topo.pot_input = -1;
+
+    char line[128];
+    int lineno = 0;
+    int err = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (parse_line(&topo, path, ++lineno, line) < 0) err = -1;
+    }
+    fclose(f);
+
+    for (int i = 0; i < topo.num_inputs && err == 0; i++) {
+        if (topo.inputs[i].channel >= topo.num_channels) {
+            printf("%s: input %d triggers channel %d, which is not defined\n", path, i, topo.inputs[i].channel);
+            err = -1;
+        }
+    }
+    if (err == 0 && (topo.num_channels == 0 || topo.num_inputs == (topo.pot_input >= 0))) {
+        printf("%s: needs at least one channel and one pad input\n", path);
+        err = -1;
+    }
+    if (err < 0) {
+        printf("Topology file %s rejected, using the built-in wiring\n", path);
+        return -1;
+    }
+
+    topology = topo;
+    printf("Loaded topology from %s: %d inputs, %d channels in %dx%d\n", path,
+           topology.num_inputs, topology.num_channels, topology.cols, topology.rows);
+    return 0;
+}
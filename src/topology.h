@@ -0,0 +1,69 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <stdint.h>
+
+// Up to four ADS1115 (ADDR pin to GND, VDD, SDA, SCL: 0x48-0x4B) with 4 inputs each
+#define TOPO_FIRST_ADDR  0x48
+#define TOPO_MAX_CHIPS   4
+#define TOPO_CHIP_INPUTS 4
+#define TOPO_MAX_INPUTS  (TOPO_MAX_CHIPS * TOPO_CHIP_INPUTS)
+
+// Pads on the main screen, one per channel
+#define TOPO_MAX_CHANNELS 16
+// Largest channel grid, the panels get smaller as it grows
+#define TOPO_MAX_GRID     4
+
+// Channel of the input wired to the volume pot
+#define TOPO_POT          (-1)
+
+#define TOPO_DEFAULT_FILE "drumkit.topo"
+
+// Conversion settings of an input without gain= / sps=: the widest range
+// (+-6.144 V) at the fastest rate, the config every input used to get
+#define TOPO_DEFAULT_FSR_MV 6144
+#define TOPO_DEFAULT_SPS    860
+// fsr_mv of an input whose gain follows its peaks (gain=auto)
+#define TOPO_GAIN_AUTO      0
+
+typedef struct {
+    uint8_t addr;       // I2C address of the chip
+    uint8_t ain;        // 0-3
+    int8_t channel;     // channel the pad triggers, or TOPO_POT
+    uint16_t fsr_mv;    // PGA full scale, or TOPO_GAIN_AUTO
+    uint16_t sps;       // ADS1115 data rate
+} TopoInput;
+
+typedef struct {
+    uint8_t sound;      // SoundType at startup
+    uint8_t col;        // cell of the panel on the main screen
+    uint8_t row;
+} TopoChannel;
+
+// The index of an input is its place in the ADC frame (values[] of
+// process_ads_triggers) and in the calibration file
+typedef struct {
+    int num_inputs;
+    TopoInput inputs[TOPO_MAX_INPUTS];
+    int num_channels;
+    TopoChannel channels[TOPO_MAX_CHANNELS];
+    uint8_t cols;       // grid size, from the cells in use
+    uint8_t rows;
+    int pot_input;      // -1 without a volume pot
+} Topology;
+
+extern Topology topology;
+
+// The file has one item per line, # starts a comment:
+//   input <addr> <ain> <channel|pot> [gain=<mV>|auto] [sps=<rate>]
+//                                      ADC inputs, in frame order
+//   channel <n> <sound> <col> <row>    n = 0, 1, ... sound as in sound_names
+// gain is one of the ADS1115 full scales (6144 4096 2048 1024 512 256),
+// auto starts at 6144 and follows the peaks of the hits (pads only).
+// sps is one of the ADS1115 rates (8 ... 860), slower is less noisy
+// Defaults to the original wiring (2 chips, pot + 5 pads, 3x2 grid), then
+// loads path if it exists. Returns 0 if the file was loaded; a file with
+// errors is rejected as a whole and the defaults stay
+int topology_init(const char *path);
+
+#endif
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "trigger_out.h"
+#include "sounds.h"
+
+// General MIDI percussion: note-on on channel 10
+#define MIDI_NOTE_ON    0x99
+#define MIDI_MAX_CARDS  8
+
+// GM drum map note of every SoundType
+static const uint8_t midi_notes[SOUND_COUNT] = {
+    [SOUND_KICK]       = 36,    // Bass Drum 1
+    [SOUND_SNARE]      = 38,    // Acoustic Snare
+    [SOUND_HIHAT]      = 42,    // Closed Hi-Hat
+    [SOUND_OPEN_HIHAT] = 46,    // Open Hi-Hat
+    [SOUND_BASS_TOM]   = 41,    // Low Floor Tom
+    [SOUND_MED_TOM]    = 47,    // Low-Mid Tom
+    [SOUND_HIGH_TOM]   = 50,    // High Tom
+    [SOUND_CRASH]      = 49,    // Crash Cymbal 1
+};
+
+static int midi_fd = -1;
+
+// Note-on of every sound, built once, only the velocity byte changes
+static uint8_t note_msgs[SOUND_COUNT][3];
+
+// Bytes of the frame, written by midi_flush with one write()
+static uint8_t out_buf[TRIGGER_OUT_MAX_HITS * 2 * 3];
+static int out_len;
+
+// Status byte already in out_buf, repeated ones are left out. Every write
+// starts with its own: a receiver powered up or plugged in since the last
+// one, or that lost bytes, still reads the frame
+static uint8_t running_status;
+
+// DRUM_MIDI_NOTE_OFF: a note-off (note-on at velocity 0) a frame after
+// every hit, for samplers that do not play drums one-shot
+static bool send_note_off;
+static uint32_t off_pending;    // sounds of the previous frame
+static uint32_t off_next;       // sounds of this frame
+
+// hw:<card>,<device> or a path, NULL for the first card with a rawmidi
+// device (snd-virmidi when the board has no MIDI port)
+static int midi_open_device(const char *dest) {
+    char path[64];
+    int card, device;
+
+    if (dest != NULL) {
+        if (sscanf(dest, "hw:%d,%d", &card, &device) == 2) {
+            snprintf(path, sizeof(path), "/dev/snd/midiC%dD%d", card, device);
+        } else {
+            snprintf(path, sizeof(path), "%s", dest);
+        }
+        int fd = open(path, O_WRONLY | O_NONBLOCK);
+        if (fd < 0) perror(path);
+        else printf("MIDI output on %s\n", path);
+        return fd;
+    }
+
+    for (card = 0; card < MIDI_MAX_CARDS; card++) {
+        snprintf(path, sizeof(path), "/dev/snd/midiC%dD0", card);
+        int fd = open(path, O_WRONLY | O_NONBLOCK);
+        if (fd >= 0) {
+            printf("MIDI output on %s\n", path);
+            return fd;
+        }
+    }
+    printf("No rawmidi device found (modprobe snd-virmidi for a virtual one)\n");
+    return -1;
+}
+
+static int midi_open(const char *dest) {
+    midi_fd = midi_open_device(dest);
+    if (midi_fd < 0) {
+        return -1;
+    }
+    for (int sound = 0; sound < SOUND_COUNT; sound++) {
+        note_msgs[sound][0] = MIDI_NOTE_ON;
+        note_msgs[sound][1] = midi_notes[sound];
+        note_msgs[sound][2] = 0;
+    }
+    out_len = 0;
+    running_status = 0;
+    send_note_off = getenv("DRUM_MIDI_NOTE_OFF") != NULL;
+    off_pending = 0;
+    off_next = 0;
+    return 0;
+}
+
+// One prebuilt message into the frame, without the status byte while it
+// is the running status
+static void midi_put(int sound, uint8_t velocity) {
+    const uint8_t *msg = note_msgs[sound];
+    if (out_len + 3 > (int)sizeof(out_buf)) {
+        return;
+    }
+    if (msg[0] != running_status) {
+        out_buf[out_len++] = msg[0];
+        running_status = msg[0];
+    }
+    out_buf[out_len++] = msg[1];
+    out_buf[out_len++] = velocity;
+}
+
+static void midi_hit(int sound, float velocity) {
+    // Velocity 0 would be a note-off, the softest hit is 1
+    int v = 1 + (int)(velocity * 126.0f + 0.5f);
+    if (v > 127) v = 127;
+
+    // A hit again before its note-off went out: that one goes first
+    if (off_pending & (1u << sound)) {
+        midi_put(sound, 0);
+        off_pending &= ~(1u << sound);
+    }
+    midi_put(sound, v);
+    if (send_note_off) off_next |= 1u << sound;
+}
+
+static void midi_flush(void) {
+    for (int sound = 0; sound < SOUND_COUNT; sound++) {
+        if (off_pending & (1u << sound)) midi_put(sound, 0);
+    }
+    off_pending = off_next;
+    off_next = 0;
+
+    if (out_len == 0) {
+        return;
+    }
+    ssize_t n = write(midi_fd, out_buf, out_len);
+    if (n != out_len) {
+        printf("MIDI: %zd of %d bytes written: %s\n", n, out_len, n < 0 ? strerror(errno) : "short write");
+    }
+    out_len = 0;
+    running_status = 0;
+}
+
+static void midi_close(void) {
+    close(midi_fd);
+    midi_fd = -1;
+}
+
+const TriggerOutput trigger_out_midi = {
+    .name = "midi",
+    .open = midi_open,
+    .hit = midi_hit,
+    .flush = midi_flush,
+    .close = midi_close,
+};
@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <lo/lo.h>
+
+#include "trigger_out.h"
+#include "sounds.h"
+#include "synth_control.h"
+
+static lo_address osc_addr;
+
+// Count of the next hit of every sound (sound_hit_value), from the clock
+// at open so a restarted controller does not repeat the last value
+static unsigned hit_count[SOUND_COUNT];
+
+static const char *hit_prefix = "/drumkit/";
+
+// OSC path of every sound, built once. They outlive the bundles that point to them
+static char sound_paths[SOUND_COUNT][32];
+
+// Hits of the frame being processed, sent together by osc_flush
+typedef struct {
+    uint8_t sound;
+    float value;
+} PendingHit;
+static PendingHit frame_hits[TRIGGER_OUT_MAX_HITS];
+static int num_frame_hits;
+
+void trigger_osc_set_prefix(const char *prefix) {
+    hit_prefix = prefix;
+}
+
+static int osc_open(const char *dest) {
+    osc_addr = synth_address_new(dest);
+    if (osc_addr == NULL) {
+        return -1;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    for (int sound = 0; sound < SOUND_COUNT; sound++) {
+        snprintf(sound_paths[sound], sizeof(sound_paths[sound]), "%s%s", hit_prefix, sound_names[sound]);
+        hit_count[sound] = (unsigned)(ts.tv_nsec / 1000);
+    }
+    num_frame_hits = 0;
+    return 0;
+}
+
+static void osc_hit(int sound, float velocity) {
+    if (num_frame_hits == TRIGGER_OUT_MAX_HITS) {
+        return;
+    }
+    frame_hits[num_frame_hits].sound = sound;
+    frame_hits[num_frame_hits].value = sound_hit_value(hit_count[sound]++, velocity);
+    num_frame_hits++;
+}
+
+// The held hits in one datagram: a lone hit as a plain message, several
+// as a bundle (immediate timetag) that the synth reads in one go, so hits
+// of the same frame start in the same audio block
+static void osc_flush(void) {
+    if (num_frame_hits == 1) {
+        if (lo_send(osc_addr, sound_paths[frame_hits[0].sound], "f", (double)frame_hits[0].value) < 0) {
+            printf("OSC: hit not sent: %s\n", lo_address_errstr(osc_addr));
+        }
+    } else if (num_frame_hits > 1) {
+        lo_bundle bundle = lo_bundle_new(LO_TT_IMMEDIATE);
+        for (int i = 0; i < num_frame_hits; i++) {
+            lo_message msg = lo_message_new();
+            lo_message_add_float(msg, frame_hits[i].value);
+            lo_bundle_add_message(bundle, sound_paths[frame_hits[i].sound], msg);
+        }
+        if (lo_send_bundle(osc_addr, bundle) < 0) {
+            printf("OSC: bundle of %d hits not sent: %s\n", num_frame_hits, lo_address_errstr(osc_addr));
+        }
+        lo_bundle_free_recursive(bundle);
+    }
+    num_frame_hits = 0;
+}
+
+static void osc_close(void) {
+    lo_address_free(osc_addr);
+    osc_addr = NULL;
+}
+
+const TriggerOutput trigger_out_osc = {
+    .name = "osc",
+    .open = osc_open,
+    .hit = osc_hit,
+    .flush = osc_flush,
+    .close = osc_close,
+};
@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "trigger_out.h"
+
+static const TriggerOutput *backends[] = {
+    &trigger_out_osc,
+    &trigger_out_midi,
+};
+
+// NULL until trigger_out_init succeeds
+static const TriggerOutput *out;
+
+int trigger_out_init(const char *name, const char *dest) {
+    trigger_out_close();
+
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+        if (strcmp(backends[i]->name, name) != 0) continue;
+        if (backends[i]->open(dest) < 0) {
+            printf("Trigger output %s failed to open\n", name);
+            return -1;
+        }
+        out = backends[i];
+        return 0;
+    }
+    printf("Unknown trigger output %s, use osc or midi\n", name);
+    return -1;
+}
+
+void trigger_out_hit(int sound, float velocity) {
+    if (out != NULL) out->hit(sound, velocity);
+}
+
+void trigger_out_flush(void) {
+    if (out != NULL) out->flush();
+}
+
+void trigger_out_close(void) {
+    if (out != NULL) out->close();
+    out = NULL;
+}
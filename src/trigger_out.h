@@ -0,0 +1,36 @@
+#ifndef TRIGGER_OUT_H
+#define TRIGGER_OUT_H
+
+// Hits a backend holds between two flushes, one per pad at most plus the key
+#define TRIGGER_OUT_MAX_HITS 32
+
+// Where the hits go. One backend is active, picked at startup
+typedef struct {
+    const char *name;
+    // dest is backend specific, NULL for its default. Returns -1 on failure
+    int (*open)(const char *dest);
+    // One hit of a sound (SoundType), velocity 0-1. Held until flush
+    void (*hit)(int sound, float velocity);
+    // End of an acquisition frame, the held hits leave together
+    void (*flush)(void);
+    void (*close)(void);
+} TriggerOutput;
+
+// The Faust synth over OSC, dest "host:port" (localhost:5510)
+extern const TriggerOutput trigger_out_osc;
+// A rawmidi device, dest a /dev/snd/midiC*D* path or hw:<card>,<device>
+extern const TriggerOutput trigger_out_midi;
+
+// Hit controls the OSC backend writes, + the sound name. The pads'
+// (/drumkit/) unless set before trigger_out_init
+void trigger_osc_set_prefix(const char *prefix);
+
+// Opens the backend called name ("osc" or "midi"). Returns -1 if the name
+// is unknown or the backend failed to open, the hits are then dropped
+int trigger_out_init(const char *name, const char *dest);
+
+void trigger_out_hit(int sound, float velocity);
+void trigger_out_flush(void);
+void trigger_out_close(void);
+
+#endif
@@ -0,0 +1,789 @@
+/*******************************************************************************
+ * Generated by scripts/gen_font_subset.py from lvgl/src/font/lv_font_montserrat_12.c, do not edit
+ * Size: 12 px, Bpp: 4, 46 glyphs
+ * Characters:  %.0123456789BCDFHKMOPRSTVacdefghiklmnoprstuyz
+ ******************************************************************************/
+
+#include "../ui.h"
+
+/*Store the image of the glyphs*/
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
+    /* U+0020 " " */
+
+    /* U+0025 "%" */
+    0xa, 0xc8, 0x0, 0xc, 0x10, 0x66, 0xa, 0x20,
+    0x76, 0x0, 0x83, 0x7, 0x42, 0xc0, 0x0, 0x57,
+    0xa, 0x2b, 0x20, 0x0, 0x9, 0xc6, 0x68, 0x5c,
+    0x90, 0x0, 0x1, 0xc1, 0xc0, 0x67, 0x0, 0xa,
+    0x43, 0x90, 0x2a, 0x0, 0x49, 0x1, 0xb0, 0x47,
+    0x0, 0xc1, 0x0, 0x7b, 0xb1,
+
+    /* U+002E "." */
+    0x2a, 0x4, 0xd0,
+
+    /* U+0030 "0" */
+    0x0, 0x9e, 0xe9, 0x0, 0xa, 0xd4, 0x4d, 0xa0,
+    0x1f, 0x20, 0x2, 0xf1, 0x5e, 0x0, 0x0, 0xd5,
+    0x6c, 0x0, 0x0, 0xc6, 0x5e, 0x0, 0x0, 0xd5,
+    0x1f, 0x20, 0x2, 0xf1, 0xa, 0xd4, 0x4d, 0xa0,
+    0x0, 0x9e, 0xe9, 0x0,
+
+    /* U+0031 "1" */
+    0xef, 0xf3, 0x22, 0xf3, 0x0, 0xf3, 0x0, 0xf3,
+    0x0, 0xf3, 0x0, 0xf3, 0x0, 0xf3, 0x0, 0xf3,
+    0x0, 0xf3,
+
+    /* U+0032 "2" */
+    0x19, 0xef, 0xc2, 0x8, 0xb4, 0x3a, 0xe0, 0x0,
+    0x0, 0x2f, 0x10, 0x0, 0x5, 0xe0, 0x0, 0x2,
+    0xe5, 0x0, 0x1, 0xd7, 0x0, 0x1, 0xd8, 0x0,
+    0x1, 0xda, 0x22, 0x21, 0x8f, 0xff, 0xff, 0x70,
+
+    /* U+0033 "3" */
+    0x9f, 0xff, 0xff, 0x1, 0x22, 0x2d, 0x80, 0x0,
+    0x9, 0xb0, 0x0, 0x5, 0xf2, 0x0, 0x0, 0x7c,
+    0xf8, 0x0, 0x0, 0x2, 0xf2, 0x0, 0x0, 0xe,
+    0x4b, 0x94, 0x39, 0xf1, 0x3b, 0xff, 0xc3, 0x0,
+
+    /* U+0034 "4" */
+    0x0, 0x0, 0x9b, 0x0, 0x0, 0x4, 0xe1, 0x0,
+    0x0, 0x1e, 0x50, 0x0, 0x0, 0xaa, 0x0, 0x0,
+    0x5, 0xe1, 0xd, 0x40, 0x1e, 0x40, 0xd, 0x40,
+    0x8f, 0xff, 0xff, 0xfd, 0x12, 0x22, 0x2e, 0x62,
+    0x0, 0x0, 0xe, 0x40,
+
+    /* U+0035 "5" */
+    0xc, 0xff, 0xff, 0x0, 0xe5, 0x22, 0x20, 0xf,
+    0x10, 0x0, 0x1, 0xff, 0xeb, 0x30, 0x2, 0x23,
+    0x9f, 0x10, 0x0, 0x0, 0xd6, 0x0, 0x0, 0xd,
+    0x69, 0xb4, 0x38, 0xf1, 0x2a, 0xef, 0xc4, 0x0,
+
+    /* U+0036 "6" */
+    0x0, 0x6d, 0xfd, 0x50, 0x8, 0xd5, 0x23, 0x20,
+    0x1f, 0x20, 0x0, 0x0, 0x4d, 0x6d, 0xea, 0x10,
+    0x6f, 0xc4, 0x3c, 0xa0, 0x5f, 0x30, 0x2, 0xf0,
+    0x2f, 0x20, 0x2, 0xf0, 0xa, 0xc3, 0x2b, 0xa0,
+    0x1, 0xaf, 0xfa, 0x10,
+
+    /* U+0037 "7" */
+    0xaf, 0xff, 0xff, 0xba, 0x92, 0x22, 0xd7, 0x76,
+    0x0, 0x3f, 0x10, 0x0, 0xa, 0x90, 0x0, 0x1,
+    0xf2, 0x0, 0x0, 0x7c, 0x0, 0x0, 0xe, 0x50,
+    0x0, 0x5, 0xe0, 0x0, 0x0, 0xc8, 0x0, 0x0,
+
+    /* U+0038 "8" */
+    0x3, 0xcf, 0xea, 0x10, 0xe, 0x81, 0x2c, 0xa0,
+    0x2f, 0x10, 0x5, 0xd0, 0xe, 0x70, 0x1b, 0x90,
+    0x6, 0xff, 0xff, 0x20, 0x3f, 0x50, 0x18, 0xe0,
+    0x6c, 0x0, 0x0, 0xf2, 0x3f, 0x61, 0x29, 0xe0,
+    0x5, 0xcf, 0xfb, 0x20,
+
+    /* U+0039 "9" */
+    0x7, 0xef, 0xc3, 0x6, 0xe3, 0x15, 0xe1, 0x98,
+    0x0, 0xb, 0x87, 0xd2, 0x3, 0xfb, 0xa, 0xff,
+    0xd9, 0xc0, 0x0, 0x10, 0x8b, 0x0, 0x0, 0xd,
+    0x70, 0x62, 0x4b, 0xd0, 0x1c, 0xfe, 0xa1, 0x0,
+
+    /* U+0042 "B" */
+    0xbf, 0xff, 0xfb, 0x20, 0xb7, 0x11, 0x2a, 0xd0,
+    0xb7, 0x0, 0x3, 0xf0, 0xb7, 0x0, 0x8, 0xc0,
+    0xbf, 0xff, 0xff, 0x50, 0xb8, 0x22, 0x26, 0xf2,
+    0xb7, 0x0, 0x0, 0xc7, 0xb7, 0x11, 0x15, 0xf4,
+    0xbf, 0xff, 0xfd, 0x60,
+
+    /* U+0043 "C" */
+    0x0, 0x3b, 0xef, 0xb3, 0x0, 0x5f, 0x93, 0x38,
+    0xe0, 0xe, 0x60, 0x0, 0x0, 0x4, 0xe0, 0x0,
+    0x0, 0x0, 0x6c, 0x0, 0x0, 0x0, 0x4, 0xe0,
+    0x0, 0x0, 0x0, 0xe, 0x60, 0x0, 0x0, 0x0,
+    0x5f, 0x93, 0x38, 0xe0, 0x0, 0x3b, 0xff, 0xb3,
+    0x0,
+
+    /* U+0044 "D" */
+    0xbf, 0xff, 0xea, 0x30, 0xb, 0x82, 0x23, 0x9f,
+    0x40, 0xb7, 0x0, 0x0, 0x7e, 0xb, 0x70, 0x0,
+    0x0, 0xf3, 0xb7, 0x0, 0x0, 0xe, 0x5b, 0x70,
+    0x0, 0x0, 0xf3, 0xb7, 0x0, 0x0, 0x7e, 0xb,
+    0x82, 0x23, 0x9f, 0x40, 0xbf, 0xff, 0xeb, 0x30,
+    0x0,
+
+    /* U+0046 "F" */
+    0xbf, 0xff, 0xff, 0x3b, 0x82, 0x22, 0x20, 0xb7,
+    0x0, 0x0, 0xb, 0x70, 0x0, 0x0, 0xbf, 0xff,
+    0xfa, 0xb, 0x82, 0x22, 0x10, 0xb7, 0x0, 0x0,
+    0xb, 0x70, 0x0, 0x0, 0xb7, 0x0, 0x0, 0x0,
+
+    /* U+0048 "H" */
+    0xb7, 0x0, 0x0, 0xb7, 0xb7, 0x0, 0x0, 0xb7,
+    0xb7, 0x0, 0x0, 0xb7, 0xb7, 0x0, 0x0, 0xb7,
+    0xbf, 0xff, 0xff, 0xf7, 0xb8, 0x22, 0x22, 0xc7,
+    0xb7, 0x0, 0x0, 0xb7, 0xb7, 0x0, 0x0, 0xb7,
+    0xb7, 0x0, 0x0, 0xb7,
+
+    /* U+004B "K" */
+    0xb7, 0x0, 0x7, 0xd1, 0xb7, 0x0, 0x5e, 0x20,
+    0xb7, 0x4, 0xe3, 0x0, 0xb7, 0x3e, 0x40, 0x0,
+    0xb9, 0xef, 0x20, 0x0, 0xbf, 0x89, 0xd0, 0x0,
+    0xba, 0x0, 0xca, 0x0, 0xb7, 0x0, 0x1e, 0x70,
+    0xb7, 0x0, 0x3, 0xf3,
+
+    /* U+004D "M" */
+    0xb8, 0x0, 0x0, 0x1, 0xf3, 0xbf, 0x10, 0x0,
+    0x9, 0xf3, 0xbe, 0xa0, 0x0, 0x2e, 0xf3, 0xb7,
+    0xe3, 0x0, 0xb7, 0xf3, 0xb6, 0x7b, 0x4, 0xd0,
+    0xf3, 0xb6, 0xd, 0x4c, 0x50, 0xf3, 0xb6, 0x5,
+    0xfc, 0x0, 0xf3, 0xb6, 0x0, 0xb3, 0x0, 0xf3,
+    0xb6, 0x0, 0x0, 0x0, 0xf3,
+
+    /* U+004F "O" */
+    0x0, 0x3b, 0xef, 0xb4, 0x0, 0x5, 0xf9, 0x33,
+    0x8f, 0x60, 0xe, 0x60, 0x0, 0x5, 0xf1, 0x4e,
+    0x0, 0x0, 0x0, 0xd5, 0x6c, 0x0, 0x0, 0x0,
+    0xb7, 0x4e, 0x0, 0x0, 0x0, 0xd5, 0xe, 0x60,
+    0x0, 0x5, 0xf1, 0x5, 0xf9, 0x33, 0x8f, 0x60,
+    0x0, 0x3b, 0xef, 0xb4, 0x0,
+
+    /* U+0050 "P" */
+    0xbf, 0xff, 0xd8, 0x0, 0xb8, 0x22, 0x5d, 0x90,
+    0xb7, 0x0, 0x4, 0xe0, 0xb7, 0x0, 0x3, 0xf0,
+    0xb7, 0x0, 0x2c, 0xa0, 0xbf, 0xff, 0xfa, 0x10,
+    0xb8, 0x22, 0x0, 0x0, 0xb7, 0x0, 0x0, 0x0,
+    0xb7, 0x0, 0x0, 0x0,
+
+    /* U+0052 "R" */
+    0xbf, 0xff, 0xd8, 0x0, 0xb8, 0x22, 0x5d, 0x90,
+    0xb7, 0x0, 0x4, 0xe0, 0xb7, 0x0, 0x3, 0xf0,
+    0xb7, 0x0, 0x1b, 0xb0, 0xbf, 0xff, 0xfb, 0x10,
+    0xb8, 0x22, 0xb9, 0x0, 0xb7, 0x0, 0x1f, 0x30,
+    0xb7, 0x0, 0x7, 0xd0,
+
+    /* U+0053 "S" */
+    0x3, 0xcf, 0xeb, 0x31, 0xf7, 0x23, 0x74, 0x4e,
+    0x0, 0x0, 0x1, 0xf9, 0x20, 0x0, 0x2, 0xbf,
+    0xd7, 0x0, 0x0, 0x4, 0xca, 0x0, 0x0, 0x4,
+    0xe5, 0xb4, 0x23, 0xbb, 0x8, 0xdf, 0xea, 0x10,
+
+    /* U+0054 "T" */
+    0xff, 0xff, 0xff, 0xf2, 0x23, 0xf3, 0x22, 0x0,
+    0x1f, 0x10, 0x0, 0x1, 0xf1, 0x0, 0x0, 0x1f,
+    0x10, 0x0, 0x1, 0xf1, 0x0, 0x0, 0x1f, 0x10,
+    0x0, 0x1, 0xf1, 0x0, 0x0, 0x1f, 0x10, 0x0,
+
+    /* U+0056 "V" */
+    0xc, 0x70, 0x0, 0x0, 0xd5, 0x6, 0xe0, 0x0,
+    0x4, 0xe0, 0x0, 0xf4, 0x0, 0xa, 0x80, 0x0,
+    0x9b, 0x0, 0x1f, 0x20, 0x0, 0x2f, 0x20, 0x7b,
+    0x0, 0x0, 0xc, 0x80, 0xe4, 0x0, 0x0, 0x5,
+    0xe5, 0xe0, 0x0, 0x0, 0x0, 0xee, 0x70, 0x0,
+    0x0, 0x0, 0x8f, 0x10, 0x0,
+
+    /* U+0061 "a" */
+    0x8, 0xdf, 0xc3, 0x0, 0xa4, 0x29, 0xd0, 0x0,
+    0x0, 0x1f, 0x10, 0x8d, 0xee, 0xf2, 0x4e, 0x10,
+    0xf, 0x24, 0xe0, 0x7, 0xf2, 0x9, 0xed, 0x8f,
+    0x20,
+
+    /* U+0063 "c" */
+    0x2, 0xbf, 0xe8, 0x0, 0xda, 0x24, 0xc3, 0x5d,
+    0x0, 0x0, 0x7, 0xb0, 0x0, 0x0, 0x5d, 0x0,
+    0x0, 0x0, 0xda, 0x24, 0xd3, 0x2, 0xbf, 0xe8,
+    0x0,
+
+    /* U+0064 "d" */
+    0x0, 0x0, 0x1, 0xf1, 0x0, 0x0, 0x1, 0xf1,
+    0x0, 0x0, 0x1, 0xf1, 0x2, 0xbf, 0xd6, 0xf1,
+    0xe, 0x92, 0x3d, 0xf1, 0x5d, 0x0, 0x4, 0xf1,
+    0x7b, 0x0, 0x1, 0xf1, 0x5d, 0x0, 0x3, 0xf1,
+    0xe, 0x91, 0x2d, 0xf1, 0x2, 0xbf, 0xe6, 0xf1,
+
+    /* U+0065 "e" */
+    0x2, 0xbf, 0xd5, 0x0, 0xe8, 0x14, 0xe4, 0x5c,
+    0x0, 0x6, 0xb7, 0xfe, 0xee, 0xec, 0x5d, 0x0,
+    0x0, 0x0, 0xe9, 0x23, 0xa2, 0x2, 0xbf, 0xe9,
+    0x0,
+
+    /* U+0066 "f" */
+    0x1, 0xcf, 0x60, 0x9a, 0x11, 0xb, 0x60, 0xd,
+    0xff, 0xf3, 0xb, 0x60, 0x0, 0xb6, 0x0, 0xb,
+    0x60, 0x0, 0xb6, 0x0, 0xb, 0x60, 0x0, 0xb6,
+    0x0,
+
+    /* U+0067 "g" */
+    0x2, 0xbf, 0xe6, 0xe2, 0xe, 0xa2, 0x3c, 0xf2,
+    0x5d, 0x0, 0x2, 0xf2, 0x7b, 0x0, 0x0, 0xf2,
+    0x5d, 0x0, 0x2, 0xf2, 0xe, 0xa2, 0x3d, 0xf2,
+    0x2, 0xbf, 0xe5, 0xf2, 0x0, 0x0, 0x2, 0xf0,
+    0xc, 0x62, 0x3b, 0xa0, 0x6, 0xdf, 0xea, 0x10,
+
+    /* U+0068 "h" */
+    0xe4, 0x0, 0x0, 0xe, 0x40, 0x0, 0x0, 0xe4,
+    0x0, 0x0, 0xe, 0x7d, 0xfc, 0x20, 0xee, 0x42,
+    0xac, 0xe, 0x60, 0x2, 0xf0, 0xe4, 0x0, 0xf,
+    0x1e, 0x40, 0x0, 0xf2, 0xe4, 0x0, 0xf, 0x2e,
+    0x40, 0x0, 0xf2,
+
+    /* U+0069 "i" */
+    0xd, 0x40, 0x82, 0x0, 0x0, 0xe4, 0xe, 0x40,
+    0xe4, 0xe, 0x40, 0xe4, 0xe, 0x40, 0xe4,
+
+    /* U+006B "k" */
+    0xe4, 0x0, 0x0, 0xe, 0x40, 0x0, 0x0, 0xe4,
+    0x0, 0x0, 0xe, 0x40, 0xb, 0xa0, 0xe4, 0xb,
+    0xb0, 0xe, 0x4b, 0xc0, 0x0, 0xee, 0xfd, 0x0,
+    0xe, 0xc1, 0xd9, 0x0, 0xe4, 0x2, 0xf4, 0xe,
+    0x40, 0x6, 0xe1,
+
+    /* U+006C "l" */
+    0xe4, 0xe4, 0xe4, 0xe4, 0xe4, 0xe4, 0xe4, 0xe4,
+    0xe4, 0xe4,
+
+    /* U+006D "m" */
+    0xe7, 0xdf, 0xb2, 0x9e, 0xe8, 0xe, 0xd3, 0x2c,
+    0xfb, 0x23, 0xe5, 0xe6, 0x0, 0x4f, 0x10, 0x9,
+    0x9e, 0x40, 0x3, 0xf0, 0x0, 0x8a, 0xe4, 0x0,
+    0x3f, 0x0, 0x8, 0xae, 0x40, 0x3, 0xf0, 0x0,
+    0x8a, 0xe4, 0x0, 0x3f, 0x0, 0x8, 0xa0,
+
+    /* U+006E "n" */
+    0xe6, 0xdf, 0xc2, 0xe, 0xe4, 0x1a, 0xc0, 0xe6,
+    0x0, 0x1f, 0xe, 0x40, 0x0, 0xf1, 0xe4, 0x0,
+    0xf, 0x2e, 0x40, 0x0, 0xf2, 0xe4, 0x0, 0xf,
+    0x20,
+
+    /* U+006F "o" */
+    0x2, 0xbf, 0xe8, 0x0, 0xe, 0xa2, 0x3e, 0x80,
+    0x5d, 0x0, 0x4, 0xf0, 0x7b, 0x0, 0x1, 0xf1,
+    0x5d, 0x0, 0x4, 0xf0, 0xd, 0xa2, 0x3e, 0x80,
+    0x2, 0xbf, 0xe8, 0x0,
+
+    /* U+0070 "p" */
+    0xe7, 0xdf, 0xc4, 0xe, 0xf4, 0x16, 0xf2, 0xe6,
+    0x0, 0xa, 0x8e, 0x40, 0x0, 0x8a, 0xe7, 0x0,
+    0xb, 0x8e, 0xf5, 0x28, 0xf2, 0xe6, 0xcf, 0xc4,
+    0xe, 0x40, 0x0, 0x0, 0xe4, 0x0, 0x0, 0xe,
+    0x40, 0x0, 0x0,
+
+    /* U+0072 "r" */
+    0xe6, 0xd8, 0xee, 0x61, 0xe7, 0x0, 0xe4, 0x0,
+    0xe4, 0x0, 0xe4, 0x0, 0xe4, 0x0,
+
+    /* U+0073 "s" */
+    0x9, 0xef, 0xc2, 0x6d, 0x22, 0x61, 0x7d, 0x20,
+    0x0, 0x9, 0xfe, 0x91, 0x0, 0x2, 0xc9, 0x56,
+    0x22, 0xb8, 0x4c, 0xfe, 0xa0,
+
+    /* U+0074 "t" */
+    0x5, 0x30, 0x0, 0xb6, 0x0, 0xdf, 0xff, 0x30,
+    0xb6, 0x0, 0xb, 0x60, 0x0, 0xb6, 0x0, 0xb,
+    0x60, 0x0, 0xaa, 0x11, 0x2, 0xdf, 0x60,
+
+    /* U+0075 "u" */
+    0xf3, 0x0, 0x2f, 0xf, 0x30, 0x2, 0xf0, 0xf3,
+    0x0, 0x2f, 0xf, 0x30, 0x2, 0xf0, 0xe4, 0x0,
+    0x4f, 0xa, 0xb2, 0x2c, 0xf0, 0x1b, 0xfe, 0x6f,
+    0x0,
+
+    /* U+0079 "y" */
+    0xd, 0x50, 0x0, 0x98, 0x7, 0xb0, 0x0, 0xe2,
+    0x1, 0xf2, 0x5, 0xc0, 0x0, 0xa7, 0xb, 0x50,
+    0x0, 0x4d, 0x1e, 0x0, 0x0, 0xe, 0xb9, 0x0,
+    0x0, 0x8, 0xf3, 0x0, 0x0, 0x5, 0xd0, 0x0,
+    0x5, 0x2c, 0x60, 0x0, 0x1c, 0xf9, 0x0, 0x0,
+
+    /* U+007A "z" */
+    0x7f, 0xff, 0xfb, 0x0, 0x2, 0xf3, 0x0, 0xc,
+    0x70, 0x0, 0x9b, 0x0, 0x4, 0xe1, 0x0, 0x1e,
+    0x50, 0x0, 0x8f, 0xff, 0xfd,
+};
+
+static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
+    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
+    {.bitmap_index = 0, .adv_w = 52, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 0, .adv_w = 162, .box_w = 10, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 45, .adv_w = 44, .box_w = 3, .box_h = 2, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 48, .adv_w = 128, .box_w = 8, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 84, .adv_w = 71, .box_w = 4, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 102, .adv_w = 110, .box_w = 7, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 134, .adv_w = 110, .box_w = 7, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 166, .adv_w = 128, .box_w = 8, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 202, .adv_w = 110, .box_w = 7, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 234, .adv_w = 118, .box_w = 8, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 270, .adv_w = 115, .box_w = 7, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 302, .adv_w = 124, .box_w = 8, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 338, .adv_w = 118, .box_w = 7, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 370, .adv_w = 145, .box_w = 8, .box_h = 9, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 406, .adv_w = 139, .box_w = 9, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 447, .adv_w = 159, .box_w = 9, .box_h = 9, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 488, .adv_w = 122, .box_w = 7, .box_h = 9, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 520, .adv_w = 156, .box_w = 8, .box_h = 9, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 556, .adv_w = 138, .box_w = 8, .box_h = 9, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 592, .adv_w = 183, .box_w = 10, .box_h = 9, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 637, .adv_w = 161, .box_w = 10, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 682, .adv_w = 139, .box_w = 8, .box_h = 9, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 718, .adv_w = 140, .box_w = 8, .box_h = 9, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 754, .adv_w = 119, .box_w = 7, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 786, .adv_w = 113, .box_w = 7, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 818, .adv_w = 137, .box_w = 10, .box_h = 9, .ofs_x = -1, .ofs_y = 0},
+    {.bitmap_index = 863, .adv_w = 115, .box_w = 7, .box_h = 7, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 888, .adv_w = 110, .box_w = 7, .box_h = 7, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 913, .adv_w = 131, .box_w = 8, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 953, .adv_w = 118, .box_w = 7, .box_h = 7, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 978, .adv_w = 68, .box_w = 5, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1003, .adv_w = 132, .box_w = 8, .box_h = 10, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 1043, .adv_w = 131, .box_w = 7, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1078, .adv_w = 54, .box_w = 3, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1093, .adv_w = 118, .box_w = 7, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1128, .adv_w = 54, .box_w = 2, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1138, .adv_w = 203, .box_w = 11, .box_h = 7, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1177, .adv_w = 131, .box_w = 7, .box_h = 7, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1202, .adv_w = 122, .box_w = 8, .box_h = 7, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1230, .adv_w = 131, .box_w = 7, .box_h = 10, .ofs_x = 1, .ofs_y = -3},
+    {.bitmap_index = 1265, .adv_w = 79, .box_w = 4, .box_h = 7, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1279, .adv_w = 96, .box_w = 6, .box_h = 7, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1300, .adv_w = 79, .box_w = 5, .box_h = 9, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1323, .adv_w = 130, .box_w = 7, .box_h = 7, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1348, .adv_w = 107, .box_w = 8, .box_h = 10, .ofs_x = -1, .ofs_y = -3},
+    {.bitmap_index = 1388, .adv_w = 100, .box_w = 6, .box_h = 7, .ofs_x = 0, .ofs_y = 0}
+};
+
+static const uint8_t glyph_id_ofs_list_0[] = {
+    0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 0, 0, 0, 0, 0,
+    0, 0, 13, 14, 15, 0, 16, 0, 17, 0, 0, 18, 0, 19, 0, 20,
+    21, 0, 22, 23, 24, 0, 25, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 26, 0, 27, 28, 29, 30, 31, 32, 33, 0, 34, 35, 36, 37, 38,
+    39, 0, 40, 41, 42, 43, 0, 0, 0, 44, 45
+};
+
+static const lv_font_fmt_txt_cmap_t cmaps[] = {
+    {
+        .range_start = 32, .range_length = 91, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = glyph_id_ofs_list_0, .list_length = 91, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL
+    }
+};
+
+static const uint8_t kern_left_class_mapping[] = {
+    0, 0, 4, 10, 12, 0, 13, 14,
+    15, 16, 17, 18, 19, 12, 24, 25,
+    22, 27, 29, 31, 29, 22, 33, 35,
+    3, 36, 37, 45, 47, 48, 49, 50,
+    51, 45, 52, 53, 48, 45, 45, 46,
+    46, 55, 56, 57, 51, 58, 60
+};
+
+static const uint8_t kern_right_class_mapping[] = {
+    0, 0, 4, 10, 12, 13, 14, 15,
+    16, 17, 12, 18, 19, 20, 25, 23,
+    25, 25, 25, 25, 25, 23, 25, 25,
+    3, 27, 29, 37, 39, 39, 39, 0,
+    39, 38, 40, 38, 38, 42, 42, 39,
+    42, 42, 43, 44, 45, 46, 48
+};
+
+static const int8_t kern_class_values[] = {
+    0, 1, 0, 0, 0, 0, 0, 0,
+    0, 1, 0, 0, 2, 0, 0, 0,
+    0, 1, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 1, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 9, 0, 5, -4, 0, 0,
+    0, 0, -11, -12, 1, 9, 4, 3,
+    -8, 1, 9, 1, 8, 2, 6, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 12, 2, -1, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 4, 0, -6, 0, 0, 0, 0,
+    0, -4, 3, 4, 0, 0, -2, 0,
+    -1, 2, 0, -2, 0, -2, -1, -4,
+    0, 0, 0, 0, -2, 0, 0, -2,
+    -3, 0, 0, -2, 0, -4, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, -2,
+    -2, 0, -3, 0, -5, 0, -23, 0,
+    0, -4, 0, 4, 6, 0, 0, -4,
+    2, 2, 6, 4, -3, 4, 0, 0,
+    -11, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -7, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, -5, -2, -9, 0, -8,
+    -1, 0, 0, 0, 0, 0, 7, 0,
+    -6, -2, -1, 1, 0, -3, 0, 0,
+    -1, -14, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, -15, -2, 7,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -8, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 6,
+    0, 2, 0, 0, -4, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 7, 2,
+    1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -7, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 1,
+    4, 2, 6, -2, 0, 0, 4, -2,
+    -6, -26, 1, 5, 4, 0, -2, 0,
+    7, 0, 6, 0, 6, 0, -18, 0,
+    -2, 6, 0, 6, -2, 4, 2, 0,
+    0, 1, -2, 0, 0, -3, 15, 0,
+    15, 0, 6, 0, 8, 2, 3, 6,
+    0, 0, 0, -7, 0, 0, 0, 0,
+    1, -1, 0, 1, -3, -2, -4, 1,
+    0, -2, 0, 0, 0, -8, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -12, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, -11, 0, -12, 0, 0, 0,
+    0, -1, 0, 19, -2, -2, 2, 2,
+    -2, 0, -2, 2, 0, 0, -10, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -19, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -12, 0, 12, 0, 0, -7, 0,
+    6, 0, -13, -19, -13, -4, 6, 0,
+    0, -13, 0, 2, -4, 0, -3, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 5, 6, -23, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 9, 0, 1, 0, 0, 0,
+    0, 0, 1, 1, -2, -4, 0, -1,
+    -1, -2, 0, 0, -1, 0, 0, 0,
+    -4, 0, -2, 0, -4, -4, 0, -5,
+    -6, -6, -4, 0, -4, 0, -4, 0,
+    0, 0, 0, -2, 0, 0, 2, 0,
+    1, -2, 0, 1, 0, 0, 0, 2,
+    -1, 0, 0, 0, -1, 2, 2, -1,
+    0, 0, 0, -4, 0, -1, 0, 0,
+    0, 0, 0, 1, 0, 2, -1, 0,
+    -2, 0, -3, 0, 0, -1, 0, 6,
+    0, 0, -2, 0, 0, 0, 0, 0,
+    -1, 1, -1, -1, 0, 0, -2, 0,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -1, -1, 0, -2, -2, 0,
+    0, 0, 0, 0, 1, 0, 0, -1,
+    0, -2, -2, -2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, -1, 0, 0,
+    0, 0, -1, -2, 0, -3, 0, -6,
+    -1, -6, 4, 0, 0, -4, 2, 4,
+    5, 0, -5, -1, -2, 0, -1, -9,
+    2, -1, 1, -10, 2, 0, 0, 1,
+    -10, 0, -10, -2, -17, -1, 0, -10,
+    0, 4, 5, 0, 2, 0, 0, 0,
+    0, 0, 0, -3, -2, 0, -6, 0,
+    0, 0, -2, 0, 0, 0, -2, 0,
+    0, 0, 0, 0, -1, -1, 0, -1,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    -2, -2, 0, -1, -2, -2, 0, 0,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -2, -2, 0, -2,
+    0, -1, 0, -4, 2, 0, 0, -2,
+    1, 2, 2, 0, 0, 0, 0, 0,
+    0, -1, 0, 0, 0, 0, 0, 1,
+    0, 0, -2, 0, -2, -1, -2, 0,
+    0, 0, 0, 0, 0, 0, 2, 0,
+    -2, 0, 0, 0, 0, -2, -3, 0,
+    -4, 0, 6, -1, 1, -6, 0, 0,
+    5, -10, -10, -8, -4, 2, 0, -2,
+    -12, -3, 0, -3, 0, -4, 3, -3,
+    -12, 0, -5, 0, 0, 1, -1, 2,
+    -1, 0, 2, 0, -6, -7, 0, -10,
+    -5, -4, -5, -6, -2, -5, 0, -4,
+    -5, 1, 0, 1, 0, -2, 0, 0,
+    0, 1, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, -2,
+    0, -1, 0, -1, -2, 0, -3, -4,
+    -4, -1, 0, -6, 0, 0, 0, 0,
+    0, 0, -2, 0, 0, 0, 0, 1,
+    -1, 0, 0, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 9, 0, 0,
+    0, 0, 0, 0, 1, 0, 0, 0,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -3, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -1, 0, 0, 0,
+    -4, 0, 0, 0, 0, -10, -6, 0,
+    0, 0, -3, -10, 0, 0, -2, 2,
+    0, -5, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -3, 0, 0, -4,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 0, -3, 0,
+    0, 0, 0, 2, 0, 1, -4, -4,
+    0, -2, -2, -2, 0, 0, 0, 0,
+    0, 0, -6, 0, -2, 0, -3, -2,
+    0, -4, -5, -6, -2, 0, -4, 0,
+    -6, 0, 0, 0, 0, 15, 0, 0,
+    1, 0, 0, -2, 0, 2, 0, -8,
+    0, 0, 0, 0, 0, -18, -3, 6,
+    6, -2, -8, 0, 2, -3, 0, -10,
+    -1, -2, 2, -13, -2, 2, 0, 3,
+    -7, -3, -7, -6, -8, 0, 0, -12,
+    0, 11, 0, 0, -1, 0, 0, 0,
+    -1, -1, -2, -5, -6, 0, -18, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -2, 0, -1, -2, -3, 0, 0,
+    -4, 0, -2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -1, 0, -4, 0, 0, 4,
+    -1, 2, 0, -4, 2, -1, -1, -5,
+    -2, 0, -2, -2, -1, 0, -3, -3,
+    0, 0, -2, -1, -1, -3, -2, 0,
+    0, -2, 0, 2, -1, 0, -4, 0,
+    0, 0, -4, 0, -3, 0, -3, -3,
+    2, 0, 0, 0, 0, 0, 0, 0,
+    0, -4, 2, 0, -3, 0, -1, -2,
+    -6, -1, -1, -1, -1, -1, -2, -1,
+    0, 0, 0, 0, 0, -2, -2, -2,
+    0, 0, 0, 0, 2, -1, 0, -1,
+    0, 0, 0, -1, -2, -1, -2, -2,
+    -2, 0, 2, 8, -1, 0, -5, 0,
+    -1, 4, 0, -2, -8, -2, 3, 0,
+    0, -9, -3, 2, -3, 1, 0, -1,
+    -2, -6, 0, -3, 1, 0, 0, -3,
+    0, 0, 0, 2, 2, -4, -4, 0,
+    -3, -2, -3, -2, -2, 0, -3, 1,
+    -4, -3, 6, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -3, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, -2, -2,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -3, 0, 0, -2,
+    0, 0, -2, -2, 0, 0, 0, 0,
+    -2, 0, 0, 0, 0, -1, 0, 0,
+    0, 0, 0, -1, 0, 0, 0, 0,
+    -3, 0, -4, 0, 0, 0, -6, 0,
+    1, -4, 4, 0, -1, -9, 0, 0,
+    -4, -2, 0, -8, -5, -5, 0, 0,
+    -8, -2, -8, -7, -9, 0, -5, 0,
+    2, 13, -2, 0, -4, -2, -1, -2,
+    -3, -5, -3, -7, -8, -4, -2, 0,
+    0, -1, 0, 1, 0, 0, -13, -2,
+    6, 4, -4, -7, 0, 1, -6, 0,
+    -10, -1, -2, 4, -18, -2, 1, 0,
+    0, -12, -2, -10, -2, -14, 0, 0,
+    -13, 0, 11, 1, 0, -1, 0, 0,
+    0, 0, -1, -1, -7, -1, 0, -12,
+    0, 0, 0, 0, -6, 0, -2, 0,
+    -1, -5, -9, 0, 0, -1, -3, -6,
+    -2, 0, -1, 0, 0, 0, 0, -9,
+    -2, -6, -6, -2, -3, -5, -2, -3,
+    0, -4, -2, -6, -3, 0, -2, -4,
+    -2, -4, 0, 1, 0, -1, -6, 0,
+    4, 0, -3, 0, 0, 0, 0, 2,
+    0, 1, -4, 8, 0, -2, -2, -2,
+    0, 0, 0, 0, 0, 0, -6, 0,
+    -2, 0, -3, -2, 0, -4, -5, -6,
+    -2, 0, -4, 2, 8, 0, 0, 0,
+    0, 15, 0, 0, 1, 0, 0, -2,
+    0, 2, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -1, -4, 0, 0, 0, 0, 0, -1,
+    0, 0, 0, -2, -2, 0, 0, -4,
+    -2, 0, 0, -4, 0, 3, -1, 0,
+    0, 0, 0, 0, 0, 1, 0, 0,
+    0, 0, 3, 4, 2, -2, 0, -6,
+    -3, 0, 6, -6, -6, -4, -4, 8,
+    3, 2, -17, -1, 4, -2, 0, -2,
+    2, -2, -7, 0, -2, 2, -2, -2,
+    -6, -2, 0, 0, 6, 4, 0, -5,
+    0, -11, -2, 6, -2, -7, 1, -2,
+    -6, -6, -2, 8, 2, 0, -3, 0,
+    -5, 0, 2, 6, -4, -7, -8, -5,
+    6, 0, 1, -14, -2, 2, -3, -1,
+    -4, 0, -4, -7, -3, -3, -2, 0,
+    0, -4, -4, -2, 0, 6, 4, -2,
+    -11, 0, -11, -3, 0, -7, -11, -1,
+    -6, -3, -6, -5, 5, 0, 0, -2,
+    0, -4, -2, 0, -2, -3, 0, 3,
+    -6, 2, 0, 0, -10, 0, -2, -4,
+    -3, -1, -6, -5, -6, -4, 0, -6,
+    -2, -4, -4, -6, -2, 0, 0, 1,
+    9, -3, 0, -6, -2, 0, -2, -4,
+    -4, -5, -5, -7, -2, -4, 4, 0,
+    -3, 0, -10, -2, 1, 4, -6, -7,
+    -4, -6, 6, -2, 1, -18, -3, 4,
+    -4, -3, -7, 0, -6, -8, -2, -2,
+    -2, -2, -4, -6, -1, 0, 0, 6,
+    5, -1, -12, 0, -12, -4, 5, -7,
+    -13, -4, -7, -8, -10, -6, 4, 0,
+    0, 0, 0, -2, 0, 0, 2, -2,
+    4, 1, -4, 4, 0, 0, -6, -1,
+    0, -1, 0, 1, 1, -2, 0, 0,
+    0, 0, 0, 0, -2, 0, 0, 0,
+    0, 2, 6, 0, 0, -2, 0, 0,
+    0, 0, -1, -1, -2, 0, 0, 0,
+    1, 2, 0, 0, 0, 0, 2, 0,
+    -2, 0, 7, 0, 3, 1, 1, -2,
+    0, 4, 0, 0, 0, 2, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 6, 0, 5, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -12, 0, -2, 3, 0, 6,
+    0, 0, 19, 2, -4, -4, 2, 2,
+    -1, 1, -10, 0, 0, 9, -12, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -13, 7, 27, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -12, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -3, 0, 0, -4,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -1, 0, -5, 0,
+    0, 1, 0, 0, 2, 25, -4, -2,
+    6, 5, -5, 2, 0, 0, 2, 2,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -25, 5, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, -5,
+    0, 0, 0, -5, 0, 0, 0, 0,
+    -4, -1, 0, 0, 0, -4, 0, -2,
+    0, -9, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, -13, 0, 0,
+    0, 0, 1, 0, 0, 0, 0, 0,
+    0, -2, 0, 0, -4, 0, -3, 0,
+    -5, 0, 0, 0, -3, 2, -2, 0,
+    0, -5, -2, -4, 0, 0, -5, 0,
+    -2, 0, -9, 0, -2, 0, 0, -16,
+    -4, -8, -2, -7, 0, 0, -13, 0,
+    -5, -1, 0, 0, 0, 0, 0, 0,
+    0, 0, -3, -3, -2, -3, 0, 0,
+    0, 0, -4, 0, -4, 2, -2, 4,
+    0, -1, -4, -1, -3, -4, 0, -2,
+    -1, -1, 1, -5, -1, 0, 0, 0,
+    -17, -2, -3, 0, -4, 0, -1, -9,
+    -2, 0, 0, -1, -2, 0, 0, 0,
+    0, 1, 0, -1, -3, -1, 3, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 2, 0, 0, 0, 0, 0,
+    0, -4, 0, -1, 0, 0, 0, -4,
+    2, 0, 0, 0, -5, -2, -4, 0,
+    0, -5, 0, -2, 0, -9, 0, 0,
+    0, 0, -19, 0, -4, -7, -10, 0,
+    0, -13, 0, -1, -3, 0, 0, 0,
+    0, 0, 0, 0, 0, -2, -3, -1,
+    -3, 1, 0, 0, 3, -2, 0, 6,
+    9, -2, -2, -6, 2, 9, 3, 4,
+    -5, 2, 8, 2, 6, 4, 5, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 12, 9, -3, -2, 0, -2,
+    15, 8, 15, 0, 0, 0, 2, 0,
+    0, 7, 0, 0, -3, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, -1, 0,
+    0, 0, 0, 0, 0, 0, 0, 3,
+    0, 0, 0, 0, -16, -2, -2, -8,
+    -9, 0, 0, -13, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, -3, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, -1,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    3, 0, 0, 0, 0, -16, -2, -2,
+    -8, -9, 0, 0, -8, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -2, 0, 0, 0, -4, 2, 0, -2,
+    2, 3, 2, -6, 0, 0, -2, 2,
+    0, 2, 0, 0, 0, 0, -5, 0,
+    -2, -1, -4, 0, -2, -8, 0, 12,
+    -2, 0, -4, -1, 0, -1, -3, 0,
+    -2, -5, -4, -2, 0, 0, 0, -3,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -1, 0, 0, 0, 0, 0, 0,
+    0, 0, 3, 0, 0, 0, 0, -16,
+    -2, -2, -8, -9, 0, 0, -13, 0,
+    0, 0, 0, 0, 0, 10, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -3, 0, -6, -2, -2, 6, -2, -2,
+    -8, 1, -1, 1, -1, -5, 0, 4,
+    0, 2, 1, 2, -5, -8, -2, 0,
+    -7, -4, -5, -8, -7, 0, -3, -4,
+    -2, -2, -2, -1, -2, -1, 0, -1,
+    -1, 3, 0, 3, -1, 0, 6, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, -1, -2, -2, 0, 0,
+    -5, 0, -1, 0, -3, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -12, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -2, -2, 0, -2,
+    0, 0, 0, 0, -2, 0, 0, -3,
+    -2, 2, 0, -3, -4, -1, 0, -6,
+    -1, -4, -1, -2, 0, -3, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -13, 0, 6, 0, 0, -3, 0,
+    0, 0, 0, -2, 0, -2, 0, 0,
+    -1, 0, 0, -1, 0, -4, 0, 0,
+    8, -2, -6, -6, 1, 2, 2, 0,
+    -5, 1, 3, 1, 6, 1, 6, -1,
+    -5, 0, 0, -8, 0, 0, -6, -5,
+    0, 0, -4, 0, -2, -3, 0, -3,
+    0, -3, 0, -1, 3, 0, -2, -6,
+    -2, 7, 0, 0, -2, 0, -4, 0,
+    0, 2, -4, 0, 2, -2, 2, 0,
+    0, -6, 0, -1, -1, 0, -2, 2,
+    -2, 0, 0, 0, -8, -2, -4, 0,
+    -6, 0, 0, -9, 0, 7, -2, 0,
+    -3, 0, 1, 0, -2, 0, -2, -6,
+    0, -2, 2, 0, 0, 0, 0, -1,
+    0, 0, 2, -2, 1, 0, 0, -2,
+    -1, 0, -2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -12, 0, 4, 0,
+    0, -2, 0, 0, 0, 0, 0, 0,
+    -2, -2, 0, 0, 0, 4, 0, 4,
+    0, 0, 0, 0, 0, -12, -11, 1,
+    8, 6, 3, -8, 1, 8, 0, 7,
+    0, 4, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 10, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0
+};
+
+static const lv_font_fmt_txt_kern_classes_t kern_classes = {
+    .class_pair_values   = kern_class_values,
+    .left_class_mapping  = kern_left_class_mapping,
+    .right_class_mapping = kern_right_class_mapping,
+    .left_class_cnt      = 61,
+    .right_class_cnt     = 49,
+};
+
+static const lv_font_fmt_txt_dsc_t font_dsc = {
+    .glyph_bitmap = glyph_bitmap,
+    .glyph_dsc = glyph_dsc,
+    .cmaps = cmaps,
+    .kern_dsc = &kern_classes,
+    .kern_scale = 16,
+    .cmap_num = 1,
+    .bpp = 4,
+    .kern_classes = 1,
+    .bitmap_format = 0,
+};
+
+const lv_font_t ui_font_montserrat_12_subset = {
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,
+    .line_height = 15,
+    .base_line = 3,
+    .subpx = LV_FONT_SUBPX_NONE,
+    .underline_position = -1,
+    .underline_thickness = 1,
+    .dsc = &font_dsc
+};
@@ -0,0 +1,835 @@
+/*******************************************************************************
+ * Generated by scripts/gen_font_subset.py from lvgl/src/font/lv_font_montserrat_14.c, do not edit
+ * Size: 14 px, Bpp: 4, 46 glyphs
+ * Characters:  %.0123456789BCDFHKMOPRSTVacdefghiklmnoprstuyz
+ ******************************************************************************/
+
+#include "../ui.h"
+
+/*Store the image of the glyphs*/
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
+    /* U+0020 " " */
+
+    /* U+0025 "%" */
+    0x8, 0xdd, 0x30, 0x0, 0xa7, 0x0, 0x4b, 0x2,
+    0xd0, 0x4, 0xc0, 0x0, 0x77, 0x0, 0xd0, 0x1d,
+    0x20, 0x0, 0x4b, 0x3, 0xd0, 0xa7, 0x0, 0x0,
+    0x7, 0xdc, 0x34, 0xc4, 0xcc, 0x30, 0x0, 0x0,
+    0x1d, 0x2d, 0x22, 0xd0, 0x0, 0x0, 0xa6, 0x3b,
+    0x0, 0xb3, 0x0, 0x5, 0xc0, 0x3a, 0x0, 0xa3,
+    0x0, 0x1d, 0x20, 0xd, 0x0, 0xd0, 0x0, 0xa6,
+    0x0, 0x4, 0xcc, 0x40,
+
+    /* U+002E "." */
+    0x0, 0x3, 0xf5, 0x2e, 0x40,
+
+    /* U+0030 "0" */
+    0x0, 0x4c, 0xfe, 0x70, 0x0, 0x4f, 0xb6, 0x8f,
+    0x90, 0xd, 0xb0, 0x0, 0x5f, 0x32, 0xf4, 0x0,
+    0x0, 0xe7, 0x4f, 0x20, 0x0, 0xc, 0xa4, 0xf2,
+    0x0, 0x0, 0xca, 0x2f, 0x40, 0x0, 0xe, 0x70,
+    0xdb, 0x0, 0x5, 0xf2, 0x4, 0xfb, 0x68, 0xf9,
+    0x0, 0x4, 0xcf, 0xe7, 0x0,
+
+    /* U+0031 "1" */
+    0xef, 0xfb, 0x44, 0xcb, 0x0, 0xab, 0x0, 0xab,
+    0x0, 0xab, 0x0, 0xab, 0x0, 0xab, 0x0, 0xab,
+    0x0, 0xab, 0x0, 0xab,
+
+    /* U+0032 "2" */
+    0x7, 0xdf, 0xea, 0x10, 0x8e, 0x85, 0x7e, 0xc0,
+    0x1, 0x0, 0x6, 0xf1, 0x0, 0x0, 0x6, 0xf0,
+    0x0, 0x0, 0xd, 0x90, 0x0, 0x0, 0xcc, 0x0,
+    0x0, 0x1c, 0xc0, 0x0, 0x1, 0xdb, 0x0, 0x0,
+    0x1d, 0xe5, 0x44, 0x42, 0x7f, 0xff, 0xff, 0xf9,
+
+    /* U+0033 "3" */
+    0x7f, 0xff, 0xff, 0xf0, 0x24, 0x44, 0x5f, 0x90,
+    0x0, 0x0, 0xbc, 0x0, 0x0, 0x9, 0xe1, 0x0,
+    0x0, 0x3f, 0xd8, 0x10, 0x0, 0x4, 0x6d, 0xd0,
+    0x0, 0x0, 0x2, 0xf4, 0x10, 0x0, 0x2, 0xf4,
+    0xbd, 0x75, 0x7d, 0xd0, 0x19, 0xdf, 0xea, 0x10,
+
+    /* U+0034 "4" */
+    0x0, 0x0, 0xd, 0xa0, 0x0, 0x0, 0x0, 0xac,
+    0x0, 0x0, 0x0, 0x7, 0xe1, 0x0, 0x0, 0x0,
+    0x4f, 0x40, 0x10, 0x0, 0x2, 0xf6, 0x0, 0xf5,
+    0x0, 0x1d, 0xa0, 0x0, 0xf5, 0x0, 0x7f, 0xff,
+    0xff, 0xff, 0xf3, 0x13, 0x33, 0x33, 0xf7, 0x30,
+    0x0, 0x0, 0x0, 0xf5, 0x0, 0x0, 0x0, 0x0,
+    0xf5, 0x0,
+
+    /* U+0035 "5" */
+    0x9, 0xff, 0xff, 0xf0, 0xa, 0xb4, 0x44, 0x40,
+    0xc, 0x80, 0x0, 0x0, 0xe, 0x70, 0x0, 0x0,
+    0xf, 0xff, 0xfc, 0x40, 0x3, 0x34, 0x5c, 0xf2,
+    0x0, 0x0, 0x0, 0xf7, 0x10, 0x0, 0x0, 0xf7,
+    0x8e, 0x85, 0x6c, 0xf1, 0x8, 0xdf, 0xfb, 0x30,
+
+    /* U+0036 "6" */
+    0x0, 0x2a, 0xef, 0xd5, 0x0, 0x3f, 0xd6, 0x57,
+    0x40, 0xc, 0xc0, 0x0, 0x0, 0x2, 0xf4, 0x0,
+    0x0, 0x0, 0x4f, 0x5b, 0xff, 0xa1, 0x4, 0xfe,
+    0x84, 0x5d, 0xd0, 0x3f, 0x80, 0x0, 0x3f, 0x30,
+    0xe8, 0x0, 0x3, 0xf2, 0x6, 0xf8, 0x45, 0xdc,
+    0x0, 0x5, 0xdf, 0xe9, 0x10,
+
+    /* U+0037 "7" */
+    0x9f, 0xff, 0xff, 0xfd, 0x9d, 0x44, 0x44, 0xe9,
+    0x9c, 0x0, 0x4, 0xf2, 0x0, 0x0, 0xb, 0xb0,
+    0x0, 0x0, 0x2f, 0x40, 0x0, 0x0, 0xad, 0x0,
+    0x0, 0x1, 0xf6, 0x0, 0x0, 0x8, 0xe0, 0x0,
+    0x0, 0xe, 0x80, 0x0, 0x0, 0x6f, 0x10, 0x0,
+
+    /* U+0038 "8" */
+    0x1, 0x9e, 0xfe, 0x91, 0x0, 0xbe, 0x63, 0x6e,
+    0xc0, 0xf, 0x60, 0x0, 0x6f, 0x0, 0xcc, 0x20,
+    0x2b, 0xc0, 0x2, 0xef, 0xff, 0xe2, 0x0, 0xdc,
+    0x42, 0x4c, 0xd0, 0x5f, 0x20, 0x0, 0x1f, 0x55,
+    0xf2, 0x0, 0x2, 0xf5, 0xe, 0xd5, 0x35, 0xde,
+    0x0, 0x1a, 0xef, 0xea, 0x10,
+
+    /* U+0039 "9" */
+    0x3, 0xbf, 0xea, 0x20, 0x2f, 0xa4, 0x4b, 0xe1,
+    0x8e, 0x0, 0x0, 0xe9, 0x9d, 0x0, 0x0, 0xdd,
+    0x4f, 0x71, 0x29, 0xff, 0x7, 0xff, 0xfc, 0x9e,
+    0x0, 0x2, 0x10, 0xac, 0x0, 0x0, 0x2, 0xf6,
+    0x7, 0x65, 0x8f, 0xb0, 0xa, 0xef, 0xd7, 0x0,
+
+    /* U+0042 "B" */
+    0x8f, 0xff, 0xfe, 0xc4, 0x8, 0xe3, 0x33, 0x4b,
+    0xf2, 0x8e, 0x0, 0x0, 0x1f, 0x58, 0xe0, 0x0,
+    0x18, 0xf1, 0x8f, 0xff, 0xff, 0xf8, 0x8, 0xe3,
+    0x33, 0x37, 0xf6, 0x8e, 0x0, 0x0, 0x9, 0xc8,
+    0xe0, 0x0, 0x0, 0x9d, 0x8e, 0x33, 0x34, 0x7f,
+    0x78, 0xff, 0xff, 0xfd, 0x70,
+
+    /* U+0043 "C" */
+    0x0, 0x7, 0xcf, 0xfb, 0x40, 0x0, 0xcf, 0x96,
+    0x6a, 0xf5, 0xa, 0xe2, 0x0, 0x0, 0x30, 0x1f,
+    0x60, 0x0, 0x0, 0x0, 0x4f, 0x20, 0x0, 0x0,
+    0x0, 0x4f, 0x20, 0x0, 0x0, 0x0, 0x1f, 0x60,
+    0x0, 0x0, 0x0, 0xa, 0xe2, 0x0, 0x0, 0x30,
+    0x1, 0xcf, 0x96, 0x6a, 0xf5, 0x0, 0x7, 0xdf,
+    0xfb, 0x40,
+
+    /* U+0044 "D" */
+    0x8f, 0xff, 0xfe, 0xa4, 0x0, 0x8e, 0x44, 0x46,
+    0xcf, 0x70, 0x8e, 0x0, 0x0, 0x7, 0xf3, 0x8e,
+    0x0, 0x0, 0x0, 0xda, 0x8e, 0x0, 0x0, 0x0,
+    0x9d, 0x8e, 0x0, 0x0, 0x0, 0x9d, 0x8e, 0x0,
+    0x0, 0x0, 0xda, 0x8e, 0x0, 0x0, 0x7, 0xf3,
+    0x8e, 0x44, 0x46, 0xbf, 0x70, 0x8f, 0xff, 0xfe,
+    0xa4, 0x0,
+
+    /* U+0046 "F" */
+    0x8f, 0xff, 0xff, 0xf6, 0x8e, 0x44, 0x44, 0x41,
+    0x8e, 0x0, 0x0, 0x0, 0x8e, 0x0, 0x0, 0x0,
+    0x8e, 0x0, 0x0, 0x0, 0x8f, 0xff, 0xff, 0xc0,
+    0x8e, 0x33, 0x33, 0x20, 0x8e, 0x0, 0x0, 0x0,
+    0x8e, 0x0, 0x0, 0x0, 0x8e, 0x0, 0x0, 0x0,
+
+    /* U+0048 "H" */
+    0x8e, 0x0, 0x0, 0x8, 0xe8, 0xe0, 0x0, 0x0,
+    0x8e, 0x8e, 0x0, 0x0, 0x8, 0xe8, 0xe0, 0x0,
+    0x0, 0x8e, 0x8f, 0xff, 0xff, 0xff, 0xe8, 0xe3,
+    0x33, 0x33, 0x9e, 0x8e, 0x0, 0x0, 0x8, 0xe8,
+    0xe0, 0x0, 0x0, 0x8e, 0x8e, 0x0, 0x0, 0x8,
+    0xe8, 0xe0, 0x0, 0x0, 0x8e,
+
+    /* U+004B "K" */
+    0x8e, 0x0, 0x0, 0x4f, 0x50, 0x8e, 0x0, 0x4,
+    0xf6, 0x0, 0x8e, 0x0, 0x3f, 0x70, 0x0, 0x8e,
+    0x3, 0xf8, 0x0, 0x0, 0x8e, 0x2e, 0xc0, 0x0,
+    0x0, 0x8e, 0xec, 0xf6, 0x0, 0x0, 0x8f, 0xb0,
+    0x7f, 0x30, 0x0, 0x8e, 0x0, 0xa, 0xe1, 0x0,
+    0x8e, 0x0, 0x0, 0xcc, 0x0, 0x8e, 0x0, 0x0,
+    0x1e, 0xa0,
+
+    /* U+004D "M" */
+    0x8e, 0x0, 0x0, 0x0, 0x8, 0xe8, 0xf7, 0x0,
+    0x0, 0x2, 0xfe, 0x8f, 0xf1, 0x0, 0x0, 0xbf,
+    0xe8, 0xdc, 0xa0, 0x0, 0x4f, 0x9e, 0x8d, 0x2f,
+    0x30, 0xd, 0x87, 0xe8, 0xd0, 0x9c, 0x6, 0xe0,
+    0x7e, 0x8d, 0x1, 0xe7, 0xe5, 0x7, 0xe8, 0xd0,
+    0x6, 0xfc, 0x0, 0x7e, 0x8d, 0x0, 0xa, 0x20,
+    0x7, 0xe8, 0xd0, 0x0, 0x0, 0x0, 0x7e,
+
+    /* U+004F "O" */
+    0x0, 0x7, 0xcf, 0xeb, 0x50, 0x0, 0x0, 0xcf,
+    0x96, 0x6b, 0xf9, 0x0, 0xa, 0xe2, 0x0, 0x0,
+    0x5f, 0x60, 0x1f, 0x60, 0x0, 0x0, 0xa, 0xd0,
+    0x4f, 0x20, 0x0, 0x0, 0x6, 0xf0, 0x4f, 0x20,
+    0x0, 0x0, 0x6, 0xf0, 0x1f, 0x60, 0x0, 0x0,
+    0xa, 0xd0, 0xa, 0xe2, 0x0, 0x0, 0x5f, 0x60,
+    0x0, 0xcf, 0x96, 0x6b, 0xfa, 0x0, 0x0, 0x7,
+    0xdf, 0xeb, 0x50, 0x0,
+
+    /* U+0050 "P" */
+    0x8f, 0xff, 0xfd, 0x70, 0x8, 0xe4, 0x45, 0x8f,
+    0xb0, 0x8e, 0x0, 0x0, 0x5f, 0x38, 0xe0, 0x0,
+    0x1, 0xf5, 0x8e, 0x0, 0x0, 0x3f, 0x48, 0xe0,
+    0x1, 0x4d, 0xd0, 0x8f, 0xff, 0xff, 0xb2, 0x8,
+    0xe3, 0x33, 0x10, 0x0, 0x8e, 0x0, 0x0, 0x0,
+    0x8, 0xe0, 0x0, 0x0, 0x0,
+
+    /* U+0052 "R" */
+    0x8f, 0xff, 0xfd, 0x70, 0x8, 0xe4, 0x45, 0x8f,
+    0xb0, 0x8e, 0x0, 0x0, 0x5f, 0x38, 0xe0, 0x0,
+    0x1, 0xf5, 0x8e, 0x0, 0x0, 0x3f, 0x38, 0xe0,
+    0x1, 0x4d, 0xd0, 0x8f, 0xff, 0xff, 0xc2, 0x8,
+    0xe3, 0x33, 0xda, 0x0, 0x8e, 0x0, 0x2, 0xf6,
+    0x8, 0xe0, 0x0, 0x5, 0xf3,
+
+    /* U+0053 "S" */
+    0x1, 0x9e, 0xfd, 0xa2, 0x0, 0xce, 0x64, 0x6b,
+    0x70, 0x2f, 0x40, 0x0, 0x0, 0x1, 0xf8, 0x0,
+    0x0, 0x0, 0x6, 0xfd, 0x95, 0x0, 0x0, 0x1,
+    0x6a, 0xee, 0x50, 0x0, 0x0, 0x0, 0x9f, 0x0,
+    0x20, 0x0, 0x5, 0xf1, 0x3f, 0xa5, 0x47, 0xeb,
+    0x0, 0x4b, 0xef, 0xe9, 0x10,
+
+    /* U+0054 "T" */
+    0xff, 0xff, 0xff, 0xff, 0x24, 0x44, 0xbd, 0x44,
+    0x40, 0x0, 0x9, 0xc0, 0x0, 0x0, 0x0, 0x9c,
+    0x0, 0x0, 0x0, 0x9, 0xc0, 0x0, 0x0, 0x0,
+    0x9c, 0x0, 0x0, 0x0, 0x9, 0xc0, 0x0, 0x0,
+    0x0, 0x9c, 0x0, 0x0, 0x0, 0x9, 0xc0, 0x0,
+    0x0, 0x0, 0x9c, 0x0, 0x0,
+
+    /* U+0056 "V" */
+    0xc, 0xb0, 0x0, 0x0, 0xa, 0xc0, 0x5f, 0x20,
+    0x0, 0x1, 0xf5, 0x0, 0xe9, 0x0, 0x0, 0x8e,
+    0x0, 0x8, 0xf0, 0x0, 0xe, 0x70, 0x0, 0x1f,
+    0x60, 0x5, 0xf1, 0x0, 0x0, 0xad, 0x0, 0xc9,
+    0x0, 0x0, 0x3, 0xf4, 0x3f, 0x30, 0x0, 0x0,
+    0xc, 0xba, 0xc0, 0x0, 0x0, 0x0, 0x5f, 0xf5,
+    0x0, 0x0, 0x0, 0x0, 0xee, 0x0, 0x0,
+
+    /* U+0061 "a" */
+    0x4, 0xcf, 0xea, 0x10, 0xb, 0x74, 0x5d, 0xb0,
+    0x0, 0x0, 0x4, 0xf0, 0x4, 0xce, 0xee, 0xf2,
+    0x1f, 0x82, 0x14, 0xf2, 0x4f, 0x10, 0x4, 0xf2,
+    0x1f, 0x70, 0x3d, 0xf2, 0x4, 0xdf, 0xd7, 0xf2,
+
+    /* U+0063 "c" */
+    0x0, 0x7d, 0xfd, 0x60, 0x9, 0xf7, 0x48, 0xf4,
+    0x2f, 0x50, 0x0, 0x20, 0x5f, 0x0, 0x0, 0x0,
+    0x5f, 0x0, 0x0, 0x0, 0x2f, 0x50, 0x0, 0x20,
+    0x9, 0xf7, 0x48, 0xf4, 0x0, 0x7d, 0xfd, 0x60,
+
+    /* U+0064 "d" */
+    0x0, 0x0, 0x0, 0x1f, 0x40, 0x0, 0x0, 0x1,
+    0xf4, 0x0, 0x0, 0x0, 0x1f, 0x40, 0x8, 0xef,
+    0xc4, 0xf4, 0xa, 0xf7, 0x48, 0xff, 0x42, 0xf5,
+    0x0, 0x7, 0xf4, 0x5f, 0x0, 0x0, 0x2f, 0x45,
+    0xf0, 0x0, 0x1, 0xf4, 0x2f, 0x50, 0x0, 0x6f,
+    0x40, 0xae, 0x63, 0x7e, 0xf4, 0x0, 0x8e, 0xfc,
+    0x4f, 0x40,
+
+    /* U+0065 "e" */
+    0x0, 0x8e, 0xfc, 0x40, 0xa, 0xd5, 0x38, 0xf4,
+    0x2f, 0x20, 0x0, 0x8c, 0x5f, 0xee, 0xee, 0xff,
+    0x5f, 0x21, 0x11, 0x11, 0x2f, 0x70, 0x0, 0x10,
+    0x9, 0xf8, 0x46, 0xe4, 0x0, 0x7d, 0xfe, 0x80,
+
+    /* U+0066 "f" */
+    0x0, 0x9e, 0xe3, 0x5, 0xf4, 0x41, 0x8, 0xc0,
+    0x0, 0xcf, 0xff, 0xf0, 0x29, 0xd3, 0x20, 0x8,
+    0xd0, 0x0, 0x8, 0xd0, 0x0, 0x8, 0xd0, 0x0,
+    0x8, 0xd0, 0x0, 0x8, 0xd0, 0x0, 0x8, 0xd0,
+    0x0,
+
+    /* U+0067 "g" */
+    0x0, 0x7e, 0xfc, 0x4e, 0x60, 0xaf, 0x74, 0x7f,
+    0xf6, 0x2f, 0x50, 0x0, 0x5f, 0x65, 0xf0, 0x0,
+    0x0, 0xf6, 0x5f, 0x0, 0x0, 0xf, 0x62, 0xf6,
+    0x0, 0x6, 0xf6, 0x9, 0xf7, 0x47, 0xff, 0x50,
+    0x7, 0xef, 0xc4, 0xf5, 0x0, 0x0, 0x0, 0x3f,
+    0x20, 0xcb, 0x64, 0x6e, 0xb0, 0x3, 0xae, 0xfd,
+    0x80, 0x0,
+
+    /* U+0068 "h" */
+    0xba, 0x0, 0x0, 0x0, 0xba, 0x0, 0x0, 0x0,
+    0xba, 0x0, 0x0, 0x0, 0xba, 0x8e, 0xfb, 0x20,
+    0xbf, 0xc5, 0x6d, 0xd0, 0xbe, 0x0, 0x3, 0xf2,
+    0xba, 0x0, 0x0, 0xf4, 0xba, 0x0, 0x0, 0xf5,
+    0xba, 0x0, 0x0, 0xf5, 0xba, 0x0, 0x0, 0xf5,
+    0xba, 0x0, 0x0, 0xf5,
+
+    /* U+0069 "i" */
+    0xba, 0xa8, 0x0, 0xba, 0xba, 0xba, 0xba, 0xba,
+    0xba, 0xba, 0xba,
+
+    /* U+006B "k" */
+    0xba, 0x0, 0x0, 0x0, 0xba, 0x0, 0x0, 0x0,
+    0xba, 0x0, 0x0, 0x0, 0xba, 0x0, 0x1c, 0xc0,
+    0xba, 0x1, 0xcc, 0x0, 0xba, 0x1c, 0xd1, 0x0,
+    0xbb, 0xcf, 0x60, 0x0, 0xbf, 0xdb, 0xe1, 0x0,
+    0xbd, 0x11, 0xdc, 0x0, 0xba, 0x0, 0x3f, 0x70,
+    0xba, 0x0, 0x7, 0xf3,
+
+    /* U+006C "l" */
+    0xba, 0xba, 0xba, 0xba, 0xba, 0xba, 0xba, 0xba,
+    0xba, 0xba, 0xba,
+
+    /* U+006D "m" */
+    0xb9, 0x9e, 0xfa, 0x15, 0xdf, 0xd4, 0xb, 0xfb,
+    0x45, 0xed, 0xe6, 0x4a, 0xf2, 0xbe, 0x0, 0x6,
+    0xf6, 0x0, 0xe, 0x7b, 0xa0, 0x0, 0x4f, 0x20,
+    0x0, 0xc9, 0xba, 0x0, 0x3, 0xf1, 0x0, 0xc,
+    0x9b, 0xa0, 0x0, 0x3f, 0x10, 0x0, 0xc9, 0xba,
+    0x0, 0x3, 0xf1, 0x0, 0xc, 0x9b, 0xa0, 0x0,
+    0x3f, 0x10, 0x0, 0xc9,
+
+    /* U+006E "n" */
+    0xb9, 0x9e, 0xfb, 0x20, 0xbf, 0xb4, 0x5d, 0xd0,
+    0xbe, 0x0, 0x3, 0xf2, 0xba, 0x0, 0x0, 0xf4,
+    0xba, 0x0, 0x0, 0xf5, 0xba, 0x0, 0x0, 0xf5,
+    0xba, 0x0, 0x0, 0xf5, 0xba, 0x0, 0x0, 0xf5,
+
+    /* U+006F "o" */
+    0x0, 0x7d, 0xfd, 0x60, 0x0, 0x9f, 0x74, 0x8f,
+    0x70, 0x2f, 0x50, 0x0, 0x7f, 0x5, 0xf0, 0x0,
+    0x1, 0xf3, 0x5f, 0x0, 0x0, 0x2f, 0x32, 0xf5,
+    0x0, 0x7, 0xf0, 0x9, 0xf7, 0x48, 0xf7, 0x0,
+    0x7, 0xdf, 0xd6, 0x0,
+
+    /* U+0070 "p" */
+    0xb9, 0x8e, 0xfc, 0x30, 0xbf, 0xc4, 0x3a, 0xf3,
+    0xbe, 0x10, 0x0, 0xca, 0xba, 0x0, 0x0, 0x7e,
+    0xba, 0x0, 0x0, 0x7e, 0xbe, 0x10, 0x0, 0xca,
+    0xbf, 0xd5, 0x5b, 0xf3, 0xba, 0x7e, 0xfc, 0x30,
+    0xba, 0x0, 0x0, 0x0, 0xba, 0x0, 0x0, 0x0,
+    0xba, 0x0, 0x0, 0x0,
+
+    /* U+0072 "r" */
+    0xb9, 0x8e, 0x4b, 0xfd, 0x71, 0xbe, 0x10, 0xb,
+    0xb0, 0x0, 0xba, 0x0, 0xb, 0xa0, 0x0, 0xba,
+    0x0, 0xb, 0xa0, 0x0,
+
+    /* U+0073 "s" */
+    0x5, 0xdf, 0xea, 0x13, 0xf7, 0x35, 0xa0, 0x6f,
+    0x0, 0x0, 0x1, 0xee, 0x96, 0x10, 0x1, 0x6a,
+    0xef, 0x30, 0x0, 0x0, 0xd9, 0x6c, 0x64, 0x6f,
+    0x62, 0xae, 0xfd, 0x70,
+
+    /* U+0074 "t" */
+    0x8, 0xd0, 0x0, 0x8, 0xd0, 0x0, 0xcf, 0xff,
+    0xf0, 0x29, 0xd3, 0x20, 0x8, 0xd0, 0x0, 0x8,
+    0xd0, 0x0, 0x8, 0xd0, 0x0, 0x8, 0xd0, 0x0,
+    0x5, 0xf5, 0x51, 0x0, 0x9f, 0xe3,
+
+    /* U+0075 "u" */
+    0xc8, 0x0, 0x2, 0xf3, 0xc8, 0x0, 0x2, 0xf3,
+    0xc8, 0x0, 0x2, 0xf3, 0xc8, 0x0, 0x2, 0xf3,
+    0xc9, 0x0, 0x3, 0xf3, 0xab, 0x0, 0x7, 0xf3,
+    0x5f, 0x83, 0x7e, 0xf3, 0x6, 0xdf, 0xc5, 0xf3,
+
+    /* U+0079 "y" */
+    0xd, 0x90, 0x0, 0xa, 0xa0, 0x6f, 0x0, 0x1,
+    0xf3, 0x0, 0xf6, 0x0, 0x7d, 0x0, 0x9, 0xc0,
+    0xd, 0x60, 0x0, 0x2f, 0x34, 0xf0, 0x0, 0x0,
+    0xc9, 0xa9, 0x0, 0x0, 0x5, 0xff, 0x20, 0x0,
+    0x0, 0xe, 0xc0, 0x0, 0x0, 0x0, 0xe5, 0x0,
+    0x0, 0x94, 0xad, 0x0, 0x0, 0x1b, 0xfc, 0x20,
+    0x0, 0x0,
+
+    /* U+007A "z" */
+    0x5f, 0xff, 0xff, 0xa1, 0x33, 0x37, 0xf4, 0x0,
+    0x1, 0xe7, 0x0, 0x0, 0xcb, 0x0, 0x0, 0x8e,
+    0x10, 0x0, 0x4f, 0x40, 0x0, 0x1e, 0xa3, 0x33,
+    0x26, 0xff, 0xff, 0xfc,
+};
+
+static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
+    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
+    {.bitmap_index = 0, .adv_w = 60, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 0, .adv_w = 189, .box_w = 12, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 60, .adv_w = 51, .box_w = 3, .box_h = 3, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 65, .adv_w = 149, .box_w = 9, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 110, .adv_w = 83, .box_w = 4, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 130, .adv_w = 129, .box_w = 8, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 170, .adv_w = 128, .box_w = 8, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 210, .adv_w = 150, .box_w = 10, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 260, .adv_w = 129, .box_w = 8, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 300, .adv_w = 138, .box_w = 9, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 345, .adv_w = 134, .box_w = 8, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 385, .adv_w = 144, .box_w = 9, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 430, .adv_w = 138, .box_w = 8, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 470, .adv_w = 170, .box_w = 9, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 515, .adv_w = 162, .box_w = 10, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 565, .adv_w = 185, .box_w = 10, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 615, .adv_w = 142, .box_w = 8, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 655, .adv_w = 182, .box_w = 9, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 700, .adv_w = 161, .box_w = 10, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 750, .adv_w = 214, .box_w = 11, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 805, .adv_w = 188, .box_w = 12, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 865, .adv_w = 162, .box_w = 9, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 910, .adv_w = 163, .box_w = 9, .box_h = 10, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 955, .adv_w = 139, .box_w = 9, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1000, .adv_w = 131, .box_w = 9, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1045, .adv_w = 159, .box_w = 11, .box_h = 10, .ofs_x = -1, .ofs_y = 0},
+    {.bitmap_index = 1100, .adv_w = 134, .box_w = 8, .box_h = 8, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1132, .adv_w = 128, .box_w = 8, .box_h = 8, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1164, .adv_w = 153, .box_w = 9, .box_h = 11, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1214, .adv_w = 137, .box_w = 8, .box_h = 8, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1246, .adv_w = 79, .box_w = 6, .box_h = 11, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1279, .adv_w = 155, .box_w = 9, .box_h = 11, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 1329, .adv_w = 153, .box_w = 8, .box_h = 11, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1373, .adv_w = 62, .box_w = 2, .box_h = 11, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1384, .adv_w = 138, .box_w = 8, .box_h = 11, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1428, .adv_w = 62, .box_w = 2, .box_h = 11, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1439, .adv_w = 237, .box_w = 13, .box_h = 8, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1491, .adv_w = 153, .box_w = 8, .box_h = 8, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1523, .adv_w = 142, .box_w = 9, .box_h = 8, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1559, .adv_w = 153, .box_w = 8, .box_h = 11, .ofs_x = 1, .ofs_y = -3},
+    {.bitmap_index = 1603, .adv_w = 92, .box_w = 5, .box_h = 8, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1623, .adv_w = 112, .box_w = 7, .box_h = 8, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1651, .adv_w = 93, .box_w = 6, .box_h = 10, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 1681, .adv_w = 152, .box_w = 8, .box_h = 8, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1713, .adv_w = 125, .box_w = 9, .box_h = 11, .ofs_x = -1, .ofs_y = -3},
+    {.bitmap_index = 1763, .adv_w = 117, .box_w = 7, .box_h = 8, .ofs_x = 0, .ofs_y = 0}
+};
+
+static const uint8_t glyph_id_ofs_list_0[] = {
+    0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 0, 0, 0, 0, 0,
+    0, 0, 13, 14, 15, 0, 16, 0, 17, 0, 0, 18, 0, 19, 0, 20,
+    21, 0, 22, 23, 24, 0, 25, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 26, 0, 27, 28, 29, 30, 31, 32, 33, 0, 34, 35, 36, 37, 38,
+    39, 0, 40, 41, 42, 43, 0, 0, 0, 44, 45
+};
+
+static const lv_font_fmt_txt_cmap_t cmaps[] = {
+    {
+        .range_start = 32, .range_length = 91, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = glyph_id_ofs_list_0, .list_length = 91, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL
+    }
+};
+
+static const uint8_t kern_left_class_mapping[] = {
+    0, 0, 4, 10, 12, 0, 13, 14,
+    15, 16, 17, 18, 19, 12, 24, 25,
+    22, 27, 29, 31, 29, 22, 33, 35,
+    3, 36, 37, 45, 47, 48, 49, 50,
+    51, 45, 52, 53, 48, 45, 45, 46,
+    46, 55, 56, 57, 51, 58, 60
+};
+
+static const uint8_t kern_right_class_mapping[] = {
+    0, 0, 4, 10, 12, 13, 14, 15,
+    16, 17, 12, 18, 19, 20, 25, 23,
+    25, 25, 25, 25, 25, 23, 25, 25,
+    3, 27, 29, 37, 39, 39, 39, 0,
+    39, 38, 40, 38, 38, 42, 42, 39,
+    42, 42, 43, 44, 45, 46, 48
+};
+
+static const int8_t kern_class_values[] = {
+    0, 1, 0, 0, 0, 0, 0, 0,
+    0, 1, 0, 0, 2, 0, 0, 0,
+    0, 2, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 1, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 10, 0, 6, -5, 0, 0,
+    0, 0, -12, -13, 2, 11, 5, 4,
+    -9, 2, 11, 1, 9, 2, 7, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 13, 2, -2, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 4, 0, -7, 0, 0, 0, 0,
+    0, -4, 4, 4, 0, 0, -2, 0,
+    -2, 2, 0, -2, 0, -2, -1, -4,
+    0, 0, 0, 0, -2, 0, 0, -3,
+    -3, 0, 0, -2, 0, -4, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, -2,
+    -2, 0, -3, 0, -6, 0, -27, 0,
+    0, -4, 0, 4, 7, 0, 0, -4,
+    2, 2, 7, 4, -4, 4, 0, 0,
+    -13, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -8, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, -6, -3, -11, 0, -9,
+    -2, 0, 0, 0, 0, 0, 9, 0,
+    -7, -2, -1, 1, 0, -4, 0, 0,
+    -2, -17, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, -18, -2, 9,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -9, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 7,
+    0, 2, 0, 0, -4, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 9, 2,
+    1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -8, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 2,
+    4, 2, 7, -2, 0, 0, 4, -2,
+    -7, -31, 2, 6, 4, 0, -3, 0,
+    8, 0, 7, 0, 7, 0, -21, 0,
+    -3, 7, 0, 7, -2, 4, 2, 0,
+    0, 1, -2, 0, 0, -4, 18, 0,
+    18, 0, 7, 0, 9, 3, 4, 7,
+    0, 0, 0, -8, 0, 0, 0, 0,
+    1, -2, 0, 2, -4, -3, -4, 2,
+    0, -2, 0, 0, 0, -9, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -15, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, -12, 0, -14, 0, 0, 0,
+    0, -2, 0, 22, -3, -3, 2, 2,
+    -2, 0, -3, 2, 0, 0, -12, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -22, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -14, 0, 13, 0, 0, -8, 0,
+    7, 0, -15, -22, -15, -4, 7, 0,
+    0, -15, 0, 3, -5, 0, -3, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 6, 7, -27, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 11, 0, 2, 0, 0, 0,
+    0, 0, 2, 2, -3, -4, 0, -1,
+    -1, -2, 0, 0, -2, 0, 0, 0,
+    -4, 0, -2, 0, -5, -4, 0, -6,
+    -7, -7, -4, 0, -4, 0, -4, 0,
+    0, 0, 0, -2, 0, 0, 2, 0,
+    2, -2, 0, 1, 0, 0, 0, 2,
+    -2, 0, 0, 0, -2, 2, 2, -1,
+    0, 0, 0, -4, 0, -1, 0, 0,
+    0, 0, 0, 1, 0, 3, -2, 0,
+    -3, 0, -4, 0, 0, -2, 0, 7,
+    0, 0, -2, 0, 0, 0, 0, 0,
+    -1, 1, -2, -2, 0, 0, -2, 0,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -1, -1, 0, -2, -3, 0,
+    0, 0, 0, 0, 1, 0, 0, -2,
+    0, -2, -2, -2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, -1, 0, 0,
+    0, 0, -2, -3, 0, -3, 0, -7,
+    -2, -7, 4, 0, 0, -4, 2, 4,
+    6, 0, -6, -1, -3, 0, -1, -11,
+    2, -2, 2, -12, 2, 0, 0, 1,
+    -12, 0, -12, -2, -19, -2, 0, -11,
+    0, 4, 6, 0, 3, 0, 0, 0,
+    0, 0, 0, -4, -3, 0, -7, 0,
+    0, 0, -2, 0, 0, 0, -2, 0,
+    0, 0, 0, 0, -1, -1, 0, -1,
+    -3, 0, 0, 0, 0, 0, 0, 0,
+    -2, -2, 0, -2, -3, -2, 0, 0,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -2, -2, 0, -3,
+    0, -2, 0, -4, 2, 0, 0, -3,
+    1, 2, 2, 0, 0, 0, 0, 0,
+    0, -2, 0, 0, 0, 0, 0, 2,
+    0, 0, -2, 0, -2, -2, -3, 0,
+    0, 0, 0, 0, 0, 0, 2, 0,
+    -2, 0, 0, 0, 0, -2, -3, 0,
+    -4, 0, 7, -2, 1, -7, 0, 0,
+    6, -11, -12, -9, -4, 2, 0, -2,
+    -15, -4, 0, -4, 0, -4, 3, -4,
+    -14, 0, -6, 0, 0, 1, -1, 2,
+    -2, 0, 2, 0, -7, -9, 0, -11,
+    -5, -5, -5, -7, -3, -6, 0, -4,
+    -6, 1, 0, 1, 0, -2, 0, 0,
+    0, 2, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, -2,
+    0, -1, 0, -1, -2, 0, -4, -5,
+    -5, -1, 0, -7, 0, 0, 0, 0,
+    0, 0, -2, 0, 0, 0, 0, 1,
+    -1, 0, 0, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 11, 0, 0,
+    0, 0, 0, 0, 2, 0, 0, 0,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -4, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -2, 0, 0, 0,
+    -4, 0, 0, 0, 0, -11, -7, 0,
+    0, 0, -3, -11, 0, 0, -2, 2,
+    0, -6, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -4, 0, 0, -4,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 0, -4, 0,
+    0, 0, 0, 3, 0, 2, -4, -4,
+    0, -2, -2, -3, 0, 0, 0, 0,
+    0, 0, -7, 0, -2, 0, -3, -2,
+    0, -5, -6, -7, -2, 0, -4, 0,
+    -7, 0, 0, 0, 0, 18, 0, 0,
+    1, 0, 0, -3, 0, 2, 0, -10,
+    0, 0, 0, 0, 0, -21, -4, 7,
+    7, -2, -9, 0, 2, -3, 0, -11,
+    -1, -3, 2, -16, -2, 3, 0, 3,
+    -8, -3, -8, -7, -9, 0, 0, -13,
+    0, 13, 0, 0, -1, 0, 0, 0,
+    -1, -1, -2, -6, -7, 0, -21, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -2, 0, -1, -2, -3, 0, 0,
+    -4, 0, -2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -1, 0, -4, 0, 0, 4,
+    -1, 3, 0, -5, 2, -2, -1, -6,
+    -2, 0, -3, -2, -2, 0, -3, -4,
+    0, 0, -2, -1, -2, -4, -3, 0,
+    0, -2, 0, 2, -2, 0, -5, 0,
+    0, 0, -4, 0, -4, 0, -4, -4,
+    2, 0, 0, 0, 0, 0, 0, 0,
+    0, -4, 2, 0, -3, 0, -2, -3,
+    -7, -2, -2, -2, -1, -2, -3, -1,
+    0, 0, 0, 0, 0, -2, -2, -2,
+    0, 0, 0, 0, 3, -2, 0, -2,
+    0, 0, 0, -2, -3, -2, -2, -3,
+    -2, 0, 2, 9, -1, 0, -6, 0,
+    -2, 4, 0, -2, -9, -3, 3, 0,
+    0, -11, -4, 2, -4, 2, 0, -2,
+    -2, -7, 0, -3, 1, 0, 0, -4,
+    0, 0, 0, 2, 2, -4, -4, 0,
+    -4, -2, -3, -2, -2, 0, -4, 1,
+    -4, -4, 7, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -4, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, -2, -2,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -3, 0, 0, -3,
+    0, 0, -2, -2, 0, 0, 0, 0,
+    -2, 0, 0, 0, 0, -1, 0, 0,
+    0, 0, 0, -2, 0, 0, 0, 0,
+    -3, 0, -4, 0, 0, 0, -7, 0,
+    2, -5, 4, 0, -2, -11, 0, 0,
+    -5, -2, 0, -9, -6, -6, 0, 0,
+    -10, -2, -9, -9, -11, 0, -6, 0,
+    2, 15, -3, 0, -5, -2, -1, -2,
+    -4, -6, -4, -8, -9, -5, -2, 0,
+    0, -2, 0, 1, 0, 0, -16, -2,
+    7, 5, -5, -8, 0, 1, -7, 0,
+    -11, -2, -2, 4, -21, -3, 1, 0,
+    0, -15, -3, -12, -2, -16, 0, 0,
+    -16, 0, 13, 1, 0, -2, 0, 0,
+    0, 0, -1, -2, -9, -2, 0, -15,
+    0, 0, 0, 0, -7, 0, -2, 0,
+    -1, -6, -11, 0, 0, -1, -3, -7,
+    -2, 0, -2, 0, 0, 0, 0, -10,
+    -2, -7, -7, -2, -4, -6, -2, -4,
+    0, -4, -2, -7, -3, 0, -3, -4,
+    -2, -4, 0, 1, 0, -2, -7, 0,
+    4, 0, -4, 0, 0, 0, 0, 3,
+    0, 2, -4, 9, 0, -2, -2, -3,
+    0, 0, 0, 0, 0, 0, -7, 0,
+    -2, 0, -3, -2, 0, -5, -6, -7,
+    -2, 0, -4, 2, 9, 0, 0, 0,
+    0, 18, 0, 0, 1, 0, 0, -3,
+    0, 2, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -2, -4, 0, 0, 0, 0, 0, -1,
+    0, 0, 0, -2, -2, 0, 0, -4,
+    -2, 0, 0, -4, 0, 4, -1, 0,
+    0, 0, 0, 0, 0, 1, 0, 0,
+    0, 0, 3, 4, 2, -2, 0, -7,
+    -4, 0, 7, -7, -7, -4, -4, 9,
+    4, 2, -19, -2, 4, -2, 0, -2,
+    2, -2, -8, 0, -2, 2, -3, -2,
+    -7, -2, 0, 0, 7, 4, 0, -6,
+    0, -12, -3, 6, -3, -9, 1, -3,
+    -7, -7, -2, 9, 2, 0, -3, 0,
+    -6, 0, 2, 7, -5, -8, -9, -6,
+    7, 0, 1, -16, -2, 2, -4, -2,
+    -5, 0, -5, -8, -3, -3, -2, 0,
+    0, -5, -5, -2, 0, 7, 5, -2,
+    -12, 0, -12, -3, 0, -8, -13, -1,
+    -7, -4, -7, -6, 6, 0, 0, -3,
+    0, -4, -2, 0, -2, -4, 0, 4,
+    -7, 2, 0, 0, -12, 0, -2, -5,
+    -4, -2, -7, -6, -7, -5, 0, -7,
+    -2, -5, -4, -7, -2, 0, 0, 1,
+    11, -4, 0, -7, -2, 0, -2, -4,
+    -5, -6, -6, -9, -3, -4, 4, 0,
+    -3, 0, -11, -3, 1, 4, -7, -8,
+    -4, -7, 7, -2, 1, -21, -4, 4,
+    -5, -4, -8, 0, -7, -9, -3, -2,
+    -2, -2, -5, -7, -1, 0, 0, 7,
+    6, -2, -15, 0, -13, -5, 5, -9,
+    -15, -4, -8, -9, -11, -7, 4, 0,
+    0, 0, 0, -3, 0, 0, 2, -3,
+    4, 2, -4, 4, 0, 0, -7, -1,
+    0, -1, 0, 1, 1, -2, 0, 0,
+    0, 0, 0, 0, -2, 0, 0, 0,
+    0, 2, 7, 0, 0, -3, 0, 0,
+    0, 0, -2, -2, -3, 0, 0, 0,
+    1, 2, 0, 0, 0, 0, 2, 0,
+    -2, 0, 9, 0, 4, 1, 1, -3,
+    0, 4, 0, 0, 0, 2, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 7, 0, 6, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -13, 0, -2, 4, 0, 7,
+    0, 0, 22, 3, -4, -4, 2, 2,
+    -2, 1, -11, 0, 0, 11, -13, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, -15, 9, 31, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -13, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -4, 0, 0, -4,
+    -2, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -2, 0, -6, 0,
+    0, 1, 0, 0, 2, 29, -4, -2,
+    7, 6, -6, 2, 0, 0, 2, 2,
+    -3, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -29, 6, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, -6,
+    0, 0, 0, -6, 0, 0, 0, 0,
+    -5, -1, 0, 0, 0, -5, 0, -3,
+    0, -11, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, -15, 0, 0,
+    0, 0, 1, 0, 0, 0, 0, 0,
+    0, -2, 0, 0, -4, 0, -3, 0,
+    -6, 0, 0, 0, -4, 2, -3, 0,
+    0, -6, -2, -5, 0, 0, -6, 0,
+    -2, 0, -11, 0, -2, 0, 0, -18,
+    -4, -9, -2, -8, 0, 0, -15, 0,
+    -6, -1, 0, 0, 0, 0, 0, 0,
+    0, 0, -3, -4, -2, -4, 0, 0,
+    0, 0, -5, 0, -5, 3, -2, 4,
+    0, -2, -5, -2, -4, -4, 0, -3,
+    -1, -2, 2, -6, -1, 0, 0, 0,
+    -20, -2, -3, 0, -5, 0, -2, -11,
+    -2, 0, 0, -2, -2, 0, 0, 0,
+    0, 2, 0, -2, -4, -2, 4, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 3, 0, 0, 0, 0, 0,
+    0, -5, 0, -2, 0, 0, 0, -4,
+    2, 0, 0, 0, -6, -2, -4, 0,
+    0, -6, 0, -2, 0, -11, 0, 0,
+    0, 0, -22, 0, -4, -8, -11, 0,
+    0, -15, 0, -2, -3, 0, 0, 0,
+    0, 0, 0, 0, 0, -2, -3, -1,
+    -3, 1, 0, 0, 4, -3, 0, 7,
+    11, -2, -2, -7, 3, 11, 4, 5,
+    -6, 3, 9, 3, 6, 5, 6, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 14, 11, -4, -2, 0, -2,
+    18, 10, 18, 0, 0, 0, 2, 0,
+    0, 8, 0, 0, -4, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, -2, 0,
+    0, 0, 0, 0, 0, 0, 0, 3,
+    0, 0, 0, 0, -19, -3, -2, -9,
+    -11, 0, 0, -15, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, -4, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, -2,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    3, 0, 0, 0, 0, -19, -3, -2,
+    -9, -11, 0, 0, -9, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -2, 0, 0, 0, -5, 2, 0, -2,
+    2, 4, 2, -7, 0, 0, -2, 2,
+    0, 2, 0, 0, 0, 0, -6, 0,
+    -2, -2, -4, 0, -2, -9, 0, 14,
+    -2, 0, -5, -2, 0, -2, -4, 0,
+    -2, -6, -4, -3, 0, 0, 0, -4,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -2, 0, 0, 0, 0, 0, 0,
+    0, 0, 3, 0, 0, 0, 0, -19,
+    -3, -2, -9, -11, 0, 0, -15, 0,
+    0, 0, 0, 0, 0, 11, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -4, 0, -7, -3, -2, 7, -2, -2,
+    -9, 1, -1, 1, -2, -6, 0, 5,
+    0, 2, 1, 2, -5, -9, -3, 0,
+    -9, -4, -6, -9, -9, 0, -4, -4,
+    -3, -3, -2, -2, -3, -2, 0, -2,
+    -1, 3, 0, 3, -2, 0, 7, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, -2, -2, -2, 0, 0,
+    -6, 0, -1, 0, -4, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -13, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -2, -2, 0, -3,
+    0, 0, 0, 0, -2, 0, 0, -4,
+    -2, 2, 0, -4, -4, -2, 0, -6,
+    -2, -5, -2, -3, 0, -4, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, -15, 0, 7, 0, 0, -4, 0,
+    0, 0, 0, -3, 0, -2, 0, 0,
+    -1, 0, 0, -2, 0, -5, 0, 0,
+    9, -3, -7, -7, 2, 2, 2, 0,
+    -6, 2, 3, 2, 7, 2, 7, -2,
+    -6, 0, 0, -9, 0, 0, -7, -6,
+    0, 0, -4, 0, -3, -4, 0, -3,
+    0, -3, 0, -2, 3, 0, -2, -7,
+    -2, 8, 0, 0, -2, 0, -4, 0,
+    0, 3, -5, 0, 2, -2, 2, 0,
+    0, -7, 0, -2, -1, 0, -2, 2,
+    -2, 0, 0, 0, -9, -3, -5, 0,
+    -7, 0, 0, -11, 0, 8, -2, 0,
+    -4, 0, 1, 0, -2, 0, -2, -7,
+    0, -2, 2, 0, 0, 0, 0, -2,
+    0, 0, 2, -3, 1, 0, 0, -3,
+    -2, 0, -3, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, -14, 0, 5, 0,
+    0, -2, 0, 0, 0, 0, 0, 0,
+    -2, -2, 0, 0, 0, 4, 0, 5,
+    0, 0, 0, 0, 0, -14, -13, 1,
+    10, 7, 4, -9, 2, 9, 0, 8,
+    0, 4, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 12, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0
+};
+
+static const lv_font_fmt_txt_kern_classes_t kern_classes = {
+    .class_pair_values   = kern_class_values,
+    .left_class_mapping  = kern_left_class_mapping,
+    .right_class_mapping = kern_right_class_mapping,
+    .left_class_cnt      = 61,
+    .right_class_cnt     = 49,
+};
+
+static const lv_font_fmt_txt_dsc_t font_dsc = {
+    .glyph_bitmap = glyph_bitmap,
+    .glyph_dsc = glyph_dsc,
+    .cmaps = cmaps,
+    .kern_dsc = &kern_classes,
+    .kern_scale = 16,
+    .cmap_num = 1,
+    .bpp = 4,
+    .kern_classes = 1,
+    .bitmap_format = 0,
+};
+
+const lv_font_t ui_font_montserrat_14_subset = {
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,
+    .line_height = 16,
+    .base_line = 3,
+    .subpx = LV_FONT_SUBPX_NONE,
+    .underline_position = -1,
+    .underline_thickness = 1,
+    .dsc = &font_dsc
+};
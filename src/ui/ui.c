@@ -31,10 +31,12 @@ void ui_init(void)
 {
     lv_disp_t * dispp = lv_disp_get_default();
     lv_theme_t * theme = lv_theme_default_init(dispp, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED),
-                                               false, LV_FONT_DEFAULT);
+                                               false, &ui_font_montserrat_14_subset);
     lv_disp_set_theme(dispp, theme);
     ui_Screen1_screen_init();
     ui_Screen2_screen_init();
+    ui_Screen3_screen_init();
+    ui_Screen4_screen_init();
     ui____initial_actions0 = lv_obj_create(NULL);
     lv_disp_load_scr(ui_Screen1);
 }
@@ -43,4 +45,6 @@ void ui_destroy(void)
 {
     ui_Screen1_screen_destroy();
     ui_Screen2_screen_destroy();
+    ui_Screen3_screen_destroy();
+    ui_Screen4_screen_destroy();
 }
@@ -28,12 +28,18 @@ extern "C" {
 ///////////////////// SCREENS ////////////////////
 #include "ui_Screen1.h"
 #include "ui_Screen2.h"
+#include "ui_Screen3.h"
+#include "ui_Screen4.h"
 
 ///////////////////// VARIABLES ////////////////////
 
 // EVENTS
 extern lv_obj_t * ui____initial_actions0;
 
+// FONTS
+LV_FONT_DECLARE(ui_font_montserrat_12_subset);
+LV_FONT_DECLARE(ui_font_montserrat_14_subset);
+
 // UI INIT
 void ui_init(void);
 void ui_destroy(void);
@@ -4,26 +4,84 @@
 // Project name: SquareLine_Project
 
 #include "ui.h"
+#include "ui_label_cache.h"
 
 lv_obj_t * ui_Screen1 = NULL;
-lv_obj_t * ui_Channel1 = NULL;
-lv_obj_t * ui_LabelCh1 = NULL;
-lv_obj_t * ui_Channel2 = NULL;
-lv_obj_t * ui_LabelCh2 = NULL;
-lv_obj_t * ui_Channel3 = NULL;
-lv_obj_t * ui_LabelCh3 = NULL;
-lv_obj_t * ui_Channel4 = NULL;
-lv_obj_t * ui_LabelCh4 = NULL;
-lv_obj_t * ui_Channel5 = NULL;
-lv_obj_t * ui_LabelCh5 = NULL;
-lv_obj_t * ui_Channel6 = NULL;
-lv_obj_t * ui_LabelCh6 = NULL;
+lv_obj_t * ui_Channel[UI_MAX_CHANNELS];
+lv_obj_t * ui_LabelCh[UI_MAX_CHANNELS];
 lv_obj_t * ui_Volume = NULL;
 lv_obj_t * ui_Label5 = NULL;
 // event funtions
 
 // build funtions
 
+// Panel grid, built from the channel cells instead of one block of setters per panel.
+// The area is the one of the original 3x2 grid of 50x50 panels
+#define UI_GRID_X 5
+#define UI_GRID_Y 18
+#define UI_GRID_W 150
+#define UI_GRID_H 100
+// Below this panel height the labels get the small font and no offset
+#define UI_COMPACT_H 40
+
+static const char * const ui_channel_text[UI_MAX_CHANNELS] = {
+    "Ch. 1", "Ch.2", "Ch.3", "Ch.4", "Ch.5", "Ch.6", "Ch.7", "Ch.8",
+    "Ch.9", "Ch.10", "Ch.11", "Ch.12", "Ch.13", "Ch.14", "Ch.15", "Ch.16",
+};
+
+static ui_channel_cell_t ui_channel_cells[UI_MAX_CHANNELS] = {
+    {0, 0}, {1, 0}, {2, 0},
+    {0, 1}, {1, 1}, {2, 1},
+};
+static uint32_t ui_channel_count = 6;
+static uint8_t ui_grid_cols = 3;
+static uint8_t ui_grid_rows = 2;
+
+void ui_Screen1_set_channel_grid(const ui_channel_cell_t * cells, uint32_t count, uint8_t cols, uint8_t rows)
+{
+    if(count > UI_MAX_CHANNELS) count = UI_MAX_CHANNELS;
+    if(cols == 0 || rows == 0) return;
+
+    lv_memcpy(ui_channel_cells, cells, count * sizeof(cells[0]));
+    ui_channel_count = count;
+    ui_grid_cols = cols;
+    ui_grid_rows = rows;
+}
+
+// Shared panel styles, built once: the highlight is the LV_STATE_FOCUSED state instead of per-panel local styles
+static lv_style_t ui_style_channel;
+static lv_style_t ui_style_channel_focused;
+static lv_style_t ui_style_channel_label;
+static lv_style_t ui_style_channel_compact;
+static lv_style_t ui_style_channel_label_compact;
+
+static void ui_Screen1_styles_init(void)
+{
+    static bool done = false;
+    if(done) return;
+
+    lv_style_init(&ui_style_channel);
+    lv_style_set_border_color(&ui_style_channel, lv_color_hex(0x4ADFF3));
+
+    lv_style_init(&ui_style_channel_compact);
+    lv_style_set_pad_all(&ui_style_channel_compact, 0);
+
+    lv_style_init(&ui_style_channel_focused);
+    lv_style_set_border_color(&ui_style_channel_focused, lv_color_black());
+
+    lv_style_init(&ui_style_channel_label);
+    lv_style_set_width(&ui_style_channel_label, LV_SIZE_CONTENT);
+    lv_style_set_height(&ui_style_channel_label, LV_SIZE_CONTENT);
+    lv_style_set_y(&ui_style_channel_label, -10);
+    lv_style_set_align(&ui_style_channel_label, LV_ALIGN_CENTER);
+
+    lv_style_init(&ui_style_channel_label_compact);
+    lv_style_set_y(&ui_style_channel_label_compact, 0);
+    lv_style_set_text_font(&ui_style_channel_label_compact, &ui_font_montserrat_12_subset);
+
+    done = true;
+}
+
 void ui_Screen1_screen_init(void)
 {
     ui_Screen1 = lv_obj_create(NULL);
@@ -31,96 +89,39 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_style_bg_color(ui_Screen1, lv_color_hex(0x4ADFF3), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_bg_opa(ui_Screen1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
 
-    ui_Channel1 = lv_obj_create(ui_Screen1);
-    lv_obj_set_width(ui_Channel1, 50);
-    lv_obj_set_height(ui_Channel1, 50);
-    lv_obj_set_x(ui_Channel1, 5);
-    lv_obj_set_y(ui_Channel1, 18);
-    lv_obj_add_state(ui_Channel1, LV_STATE_FOCUSED);       /// States
-    lv_obj_clear_flag(ui_Channel1, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_LabelCh1 = lv_label_create(ui_Channel1);
-    lv_obj_set_width(ui_LabelCh1, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_LabelCh1, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_x(ui_LabelCh1, 0);
-    lv_obj_set_y(ui_LabelCh1, -10);
-    lv_obj_set_align(ui_LabelCh1, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_LabelCh1, "Ch. 1");
-
-    ui_Channel2 = lv_obj_create(ui_Screen1);
-    lv_obj_set_width(ui_Channel2, 50);
-    lv_obj_set_height(ui_Channel2, 50);
-    lv_obj_set_x(ui_Channel2, 55);
-    lv_obj_set_y(ui_Channel2, 18);
-    lv_obj_clear_flag(ui_Channel2, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_LabelCh2 = lv_label_create(ui_Channel2);
-    lv_obj_set_width(ui_LabelCh2, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_LabelCh2, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_x(ui_LabelCh2, 0);
-    lv_obj_set_y(ui_LabelCh2, -10);
-    lv_obj_set_align(ui_LabelCh2, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_LabelCh2, "Ch.2");
-
-    ui_Channel3 = lv_obj_create(ui_Screen1);
-    lv_obj_set_width(ui_Channel3, 50);
-    lv_obj_set_height(ui_Channel3, 50);
-    lv_obj_set_x(ui_Channel3, 105);
-    lv_obj_set_y(ui_Channel3, 18);
-    lv_obj_clear_flag(ui_Channel3, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_LabelCh3 = lv_label_create(ui_Channel3);
-    lv_obj_set_width(ui_LabelCh3, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_LabelCh3, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_x(ui_LabelCh3, 0);
-    lv_obj_set_y(ui_LabelCh3, -10);
-    lv_obj_set_align(ui_LabelCh3, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_LabelCh3, "Ch.3");
-
-    ui_Channel4 = lv_obj_create(ui_Screen1);
-    lv_obj_set_width(ui_Channel4, 50);
-    lv_obj_set_height(ui_Channel4, 50);
-    lv_obj_set_x(ui_Channel4, 5);
-    lv_obj_set_y(ui_Channel4, 68);
-    lv_obj_clear_flag(ui_Channel4, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_LabelCh4 = lv_label_create(ui_Channel4);
-    lv_obj_set_width(ui_LabelCh4, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_LabelCh4, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_x(ui_LabelCh4, 0);
-    lv_obj_set_y(ui_LabelCh4, -10);
-    lv_obj_set_align(ui_LabelCh4, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_LabelCh4, "Ch.4");
-
-    ui_Channel5 = lv_obj_create(ui_Screen1);
-    lv_obj_set_width(ui_Channel5, 50);
-    lv_obj_set_height(ui_Channel5, 50);
-    lv_obj_set_x(ui_Channel5, 55);
-    lv_obj_set_y(ui_Channel5, 68);
-    lv_obj_clear_flag(ui_Channel5, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_LabelCh5 = lv_label_create(ui_Channel5);
-    lv_obj_set_width(ui_LabelCh5, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_LabelCh5, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_x(ui_LabelCh5, 0);
-    lv_obj_set_y(ui_LabelCh5, -10);
-    lv_obj_set_align(ui_LabelCh5, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_LabelCh5, "Ch.5");
-
-    ui_Channel6 = lv_obj_create(ui_Screen1);
-    lv_obj_set_width(ui_Channel6, 50);
-    lv_obj_set_height(ui_Channel6, 50);
-    lv_obj_set_x(ui_Channel6, 105);
-    lv_obj_set_y(ui_Channel6, 68);
-    lv_obj_clear_flag(ui_Channel6, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-
-    ui_LabelCh6 = lv_label_create(ui_Channel6);
-    lv_obj_set_width(ui_LabelCh6, LV_SIZE_CONTENT);   /// 1
-    lv_obj_set_height(ui_LabelCh6, LV_SIZE_CONTENT);    /// 1
-    lv_obj_set_x(ui_LabelCh6, 0);
-    lv_obj_set_y(ui_LabelCh6, -10);
-    lv_obj_set_align(ui_LabelCh6, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_LabelCh6, "Ch.6");
+    ui_Screen1_styles_init();
+
+    int32_t cell_w = UI_GRID_W / ui_grid_cols;
+    int32_t cell_h = UI_GRID_H / ui_grid_rows;
+    bool compact = cell_h < UI_COMPACT_H;
+    const lv_font_t * label_font = compact ? &ui_font_montserrat_12_subset : &ui_font_montserrat_14_subset;
+    lv_style_set_width(&ui_style_channel, cell_w);
+    lv_style_set_height(&ui_style_channel, cell_h);
+
+    for(uint32_t i = 0; i < ui_channel_count; i++) {
+        const ui_channel_cell_t * cell = &ui_channel_cells[i];
+
+        lv_obj_t * panel = lv_obj_create(ui_Screen1);
+        lv_obj_add_style(panel, &ui_style_channel, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(panel, &ui_style_channel_focused, LV_PART_MAIN | LV_STATE_FOCUSED);
+        if(compact) lv_obj_add_style(panel, &ui_style_channel_compact, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_set_pos(panel, UI_GRID_X + cell->col * cell_w, UI_GRID_Y + cell->row * cell_h);
+        lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+#if UI_USE_LABEL_CACHE
+        lv_obj_t * label = ui_label_cache_create(panel, ui_channel_text[i], label_font);
+#else
+        lv_obj_t * label = lv_label_create(panel);
+        lv_label_set_text_static(label, ui_channel_text[i]);
+        LV_UNUSED(label_font);
+#endif
+        lv_obj_add_style(label, &ui_style_channel_label, LV_PART_MAIN | LV_STATE_DEFAULT);
+        if(compact) lv_obj_add_style(label, &ui_style_channel_label_compact, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+        ui_Channel[i] = panel;
+        ui_LabelCh[i] = label;
+    }
+    if(ui_channel_count > 0) lv_obj_add_state(ui_Channel[0], LV_STATE_FOCUSED);       /// States
 
     ui_Volume = lv_slider_create(ui_Screen1);
     lv_slider_set_mode(ui_Volume, LV_SLIDER_MODE_RANGE);
@@ -138,7 +139,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Label5, -56);
     lv_obj_set_align(ui_Label5, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label5, "Volume");
-    lv_obj_set_style_text_font(ui_Label5, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_Label5, &ui_font_montserrat_12_subset, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 }
 
@@ -148,18 +149,10 @@ void ui_Screen1_screen_destroy(void)
 
     // NULL screen variables
     ui_Screen1 = NULL;
-    ui_Channel1 = NULL;
-    ui_LabelCh1 = NULL;
-    ui_Channel2 = NULL;
-    ui_LabelCh2 = NULL;
-    ui_Channel3 = NULL;
-    ui_LabelCh3 = NULL;
-    ui_Channel4 = NULL;
-    ui_LabelCh4 = NULL;
-    ui_Channel5 = NULL;
-    ui_LabelCh5 = NULL;
-    ui_Channel6 = NULL;
-    ui_LabelCh6 = NULL;
+    for(uint32_t i = 0; i < UI_MAX_CHANNELS; i++) {
+        ui_Channel[i] = NULL;
+        ui_LabelCh[i] = NULL;
+    }
     ui_Volume = NULL;
     ui_Label5 = NULL;
 
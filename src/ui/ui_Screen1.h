@@ -14,22 +14,23 @@ extern "C" {
 extern void ui_Screen1_screen_init(void);
 extern void ui_Screen1_screen_destroy(void);
 extern lv_obj_t * ui_Screen1;
-extern lv_obj_t * ui_Channel1;
-extern lv_obj_t * ui_LabelCh1;
-extern lv_obj_t * ui_Channel2;
-extern lv_obj_t * ui_LabelCh2;
-extern lv_obj_t * ui_Channel3;
-extern lv_obj_t * ui_LabelCh3;
-extern lv_obj_t * ui_Channel4;
-extern lv_obj_t * ui_LabelCh4;
-extern lv_obj_t * ui_Channel5;
-extern lv_obj_t * ui_LabelCh5;
-extern lv_obj_t * ui_Channel6;
-extern lv_obj_t * ui_LabelCh6;
+#define UI_MAX_CHANNELS 16
+extern lv_obj_t * ui_Channel[UI_MAX_CHANNELS];
+extern lv_obj_t * ui_LabelCh[UI_MAX_CHANNELS];
 extern lv_obj_t * ui_Volume;
 extern lv_obj_t * ui_Label5;
 // CUSTOM VARIABLES
 
+// Cell of a channel panel in the grid
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} ui_channel_cell_t;
+
+// Channel panels to build, call before ui_init(). The grid fills the area
+// below the volume slider. Defaults to 6 channels in 3x2
+extern void ui_Screen1_set_channel_grid(const ui_channel_cell_t * cells, uint32_t count, uint8_t cols, uint8_t rows);
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -0,0 +1,64 @@
+// This file was generated by SquareLine Studio
+// SquareLine Studio version: SquareLine Studio 1.5.3
+// LVGL version: 8.3.11
+// Project name: SquareLine_Project
+
+#include "ui.h"
+
+lv_obj_t * ui_Screen3 = NULL;
+lv_obj_t * ui_Roller2 = NULL;
+lv_obj_t * ui_LabelTempo = NULL;
+lv_obj_t * ui_LabelSeqState = NULL;
+// event funtions
+
+// build funtions
+
+void ui_Screen3_screen_init(void)
+{
+    ui_Screen3 = lv_obj_create(NULL);
+    lv_obj_clear_flag(ui_Screen3, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+    lv_obj_set_style_bg_color(ui_Screen3, lv_color_hex(0x4ADFF3), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_opa(ui_Screen3, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_Roller2 = lv_roller_create(ui_Screen3);
+    lv_obj_set_width(ui_Roller2, 90);
+    lv_obj_set_height(ui_Roller2, 108);
+    lv_obj_set_x(ui_Roller2, 5);
+    lv_obj_set_y(ui_Roller2, 10);
+
+    ui_LabelTempo = lv_label_create(ui_Screen3);
+    lv_obj_set_width(ui_LabelTempo, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelTempo, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelTempo, 100);
+    lv_obj_set_y(ui_LabelTempo, 40);
+    lv_label_set_text(ui_LabelTempo, "100 BPM");
+    lv_obj_set_style_text_font(ui_LabelTempo, &ui_font_montserrat_12_subset, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelSeqState = lv_label_create(ui_Screen3);
+    lv_obj_set_width(ui_LabelSeqState, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelSeqState, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelSeqState, 100);
+    lv_obj_set_y(ui_LabelSeqState, 70);
+    lv_label_set_text(ui_LabelSeqState, "Stopped");
+    lv_obj_set_style_text_font(ui_LabelSeqState, &ui_font_montserrat_12_subset, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+}
+
+// The texts the controller can show stay in this file, for the font subset
+void ui_Screen3_show_seq(int bpm, bool running)
+{
+    lv_label_set_text_fmt(ui_LabelTempo, "%d BPM", bpm);
+    lv_label_set_text_static(ui_LabelSeqState, running ? "Playing" : "Stopped");
+}
+
+void ui_Screen3_screen_destroy(void)
+{
+    if(ui_Screen3) lv_obj_del(ui_Screen3);
+
+    // NULL screen variables
+    ui_Screen3 = NULL;
+    ui_Roller2 = NULL;
+    ui_LabelTempo = NULL;
+    ui_LabelSeqState = NULL;
+
+}
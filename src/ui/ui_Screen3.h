@@ -0,0 +1,29 @@
+// This file was generated by SquareLine Studio
+// SquareLine Studio version: SquareLine Studio 1.5.3
+// LVGL version: 8.3.11
+// Project name: SquareLine_Project
+
+#ifndef UI_SCREEN3_H
+#define UI_SCREEN3_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SCREEN: ui_Screen3
+extern void ui_Screen3_screen_init(void);
+extern void ui_Screen3_screen_destroy(void);
+extern lv_obj_t * ui_Screen3;
+extern lv_obj_t * ui_Roller2;
+extern lv_obj_t * ui_LabelTempo;
+extern lv_obj_t * ui_LabelSeqState;
+// CUSTOM VARIABLES
+
+// Tempo and play state of the sequencer
+void ui_Screen3_show_seq(int bpm, bool running);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
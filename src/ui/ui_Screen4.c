@@ -0,0 +1,79 @@
+// This file was generated by SquareLine Studio
+// SquareLine Studio version: SquareLine Studio 1.5.3
+// LVGL version: 8.3.11
+// Project name: SquareLine_Project
+
+#include "ui.h"
+
+lv_obj_t * ui_Screen4 = NULL;
+lv_obj_t * ui_LabelEditSound = NULL;
+lv_obj_t * ui_LabelParam[UI_EDIT_ROWS];
+lv_obj_t * ui_SliderParam[UI_EDIT_ROWS];
+lv_obj_t * ui_LabelParamValue[UI_EDIT_ROWS];
+// event funtions
+
+// build funtions
+
+#define UI_EDIT_ROW_Y 26
+#define UI_EDIT_ROW_H 34
+
+void ui_Screen4_screen_init(void)
+{
+    ui_Screen4 = lv_obj_create(NULL);
+    lv_obj_clear_flag(ui_Screen4, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+    lv_obj_set_style_bg_color(ui_Screen4, lv_color_hex(0x4ADFF3), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_opa(ui_Screen4, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelEditSound = lv_label_create(ui_Screen4);
+    lv_obj_set_width(ui_LabelEditSound, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelEditSound, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelEditSound, 5);
+    lv_obj_set_y(ui_LabelEditSound, 4);
+    lv_label_set_text(ui_LabelEditSound, "");
+
+    for(int i = 0; i < UI_EDIT_ROWS; i++) {
+        int32_t y = UI_EDIT_ROW_Y + i * UI_EDIT_ROW_H;
+
+        ui_LabelParam[i] = lv_label_create(ui_Screen4);
+        lv_obj_set_width(ui_LabelParam[i], LV_SIZE_CONTENT);   /// 1
+        lv_obj_set_height(ui_LabelParam[i], LV_SIZE_CONTENT);    /// 1
+        lv_obj_set_x(ui_LabelParam[i], 5);
+        lv_obj_set_y(ui_LabelParam[i], y);
+        lv_label_set_text(ui_LabelParam[i], "");
+        lv_obj_set_style_text_font(ui_LabelParam[i], &ui_font_montserrat_12_subset, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+        ui_LabelParamValue[i] = lv_label_create(ui_Screen4);
+        lv_obj_set_width(ui_LabelParamValue[i], LV_SIZE_CONTENT);   /// 1
+        lv_obj_set_height(ui_LabelParamValue[i], LV_SIZE_CONTENT);    /// 1
+        lv_obj_set_x(ui_LabelParamValue[i], 80);
+        lv_obj_set_y(ui_LabelParamValue[i], y);
+        lv_label_set_text(ui_LabelParamValue[i], "");
+        lv_obj_set_style_text_font(ui_LabelParamValue[i], &ui_font_montserrat_12_subset, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+        ui_SliderParam[i] = lv_slider_create(ui_Screen4);
+        lv_slider_set_range(ui_SliderParam[i], 0, 1000);
+        lv_obj_set_width(ui_SliderParam[i], 140);
+        lv_obj_set_height(ui_SliderParam[i], 4);
+        lv_obj_set_x(ui_SliderParam[i], 10);
+        lv_obj_set_y(ui_SliderParam[i], y + 18);
+        // The selected row is the focused slider
+        lv_obj_set_style_bg_color(ui_SliderParam[i], lv_color_black(), LV_PART_INDICATOR | LV_STATE_FOCUSED);
+        lv_obj_set_style_bg_color(ui_SliderParam[i], lv_color_black(), LV_PART_KNOB | LV_STATE_FOCUSED);
+    }
+
+}
+
+void ui_Screen4_screen_destroy(void)
+{
+    if(ui_Screen4) lv_obj_del(ui_Screen4);
+
+    // NULL screen variables
+    ui_Screen4 = NULL;
+    ui_LabelEditSound = NULL;
+    for(int i = 0; i < UI_EDIT_ROWS; i++) {
+        ui_LabelParam[i] = NULL;
+        ui_SliderParam[i] = NULL;
+        ui_LabelParamValue[i] = NULL;
+    }
+
+}
@@ -0,0 +1,30 @@
+// This file was generated by SquareLine Studio
+// SquareLine Studio version: SquareLine Studio 1.5.3
+// LVGL version: 8.3.11
+// Project name: SquareLine_Project
+
+#ifndef UI_SCREEN4_H
+#define UI_SCREEN4_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Parameter rows of the sound edit screen
+#define UI_EDIT_ROWS 3
+
+// SCREEN: ui_Screen4
+extern void ui_Screen4_screen_init(void);
+extern void ui_Screen4_screen_destroy(void);
+extern lv_obj_t * ui_Screen4;
+extern lv_obj_t * ui_LabelEditSound;
+extern lv_obj_t * ui_LabelParam[UI_EDIT_ROWS];
+extern lv_obj_t * ui_SliderParam[UI_EDIT_ROWS];
+extern lv_obj_t * ui_LabelParamValue[UI_EDIT_ROWS];
+// CUSTOM VARIABLES
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
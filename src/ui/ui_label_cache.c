@@ -0,0 +1,152 @@
+#include <string.h>
+
+#include "ui_label_cache.h"
+
+typedef struct {
+    const char * text;
+    const lv_font_t * font;
+    lv_draw_buf_t * buf;
+    int32_t text_w;     // width the label would have, buf can be wider by the last glyph's overhang
+} ui_label_cache_entry_t;
+
+static ui_label_cache_entry_t ui_label_cache[UI_LABEL_CACHE_SIZE];
+static uint32_t ui_label_cache_count;
+
+// Next UTF-8 code point of txt at *i (lv_text_encoded_next is private API)
+static uint32_t ui_label_cache_next(const char * txt, uint32_t * i)
+{
+    const uint8_t * s = (const uint8_t *)txt + *i;
+    uint32_t len = s[0] < 0x80 ? 1 : s[0] < 0xE0 ? 2 : s[0] < 0xF0 ? 3 : 4;
+    uint32_t c = len == 1 ? s[0] : s[0] & (0x7F >> len);
+
+    for(uint32_t k = 1; k < len; k++) {
+        if((s[k] & 0xC0) != 0x80) {
+            (*i)++;
+            return '?';
+        }
+        c = (c << 6) | (s[k] & 0x3F);
+    }
+    if(c != 0) *i += len;
+    return c;
+}
+
+// Lays the glyphs out the way lv_draw_label does for a single line and
+// keeps the max coverage where neighbouring glyph boxes overlap.
+// With buf NULL only returns the width the glyph boxes need.
+static int32_t ui_label_cache_layout(const char * text, const lv_font_t * font, lv_draw_buf_t * buf)
+{
+    int32_t right = 0;
+    int32_t pen_x = 0;
+    uint32_t i = 0;
+    uint32_t letter = ui_label_cache_next(text, &i);
+    while(letter != 0) {
+        uint32_t next_i = i;
+        uint32_t letter_next = ui_label_cache_next(text, &next_i);
+
+        lv_font_glyph_dsc_t g = {0};
+        bool found = lv_font_get_glyph_dsc(font, &g, letter, letter_next);
+        if(found && g.box_w > 0 && g.box_h > 0 && buf == NULL) {
+            right = LV_MAX(right, pen_x + g.ofs_x + g.box_w);
+        }
+        else if(found && g.box_w > 0 && g.box_h > 0) {
+            lv_draw_buf_t * glyph = lv_draw_buf_create(g.box_w, g.box_h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+            // Returns the draw buffer it filled, not the pixels
+            if(glyph && lv_font_get_glyph_bitmap(&g, glyph) != NULL) {
+                const uint8_t * src = glyph->data;
+                int32_t x0 = pen_x + g.ofs_x;
+                int32_t y0 = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+                uint32_t src_stride = glyph->header.stride;
+
+                for(int32_t y = 0; y < g.box_h; y++) {
+                    if(y0 + y < 0 || y0 + y >= (int32_t)buf->header.h) continue;
+                    uint8_t * dst = buf->data + (y0 + y) * buf->header.stride;
+                    for(int32_t x = 0; x < g.box_w; x++) {
+                        if(x0 + x < 0 || x0 + x >= (int32_t)buf->header.w) continue;
+                        uint8_t a = src[y * src_stride + x];
+                        if(a > dst[x0 + x]) dst[x0 + x] = a;
+                    }
+                }
+            }
+            lv_font_glyph_release_draw_data(&g);
+            if(glyph) lv_draw_buf_destroy(glyph);
+        }
+
+        pen_x += g.adv_w;
+        letter = letter_next;
+        i = next_i;
+    }
+
+    return LV_MAX(right, pen_x);
+}
+
+static ui_label_cache_entry_t * ui_label_cache_get(const char * text, const lv_font_t * font)
+{
+    for(uint32_t i = 0; i < ui_label_cache_count; i++) {
+        ui_label_cache_entry_t * e = &ui_label_cache[i];
+        if(e->font == font && (e->text == text || strcmp(e->text, text) == 0)) return e;
+    }
+
+    if(ui_label_cache_count >= UI_LABEL_CACHE_SIZE) {
+        LV_LOG_WARN("label cache full, \"%s\" falls back to a label", text);
+        return NULL;
+    }
+
+    lv_point_t size;
+    lv_text_get_size(&size, text, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    int32_t w = LV_MAX(ui_label_cache_layout(text, font, NULL), size.x);
+
+    lv_draw_buf_t * buf = lv_draw_buf_create(LV_MAX(w, 1), LV_MAX(size.y, 1), LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if(buf == NULL) return NULL;
+    lv_draw_buf_clear(buf, NULL);
+    ui_label_cache_layout(text, font, buf);
+
+    ui_label_cache_entry_t * e = &ui_label_cache[ui_label_cache_count++];
+    e->text = text;
+    e->font = font;
+    e->buf = buf;
+    e->text_w = size.x;
+    return e;
+}
+
+static void ui_label_cache_ext_draw_cb(lv_event_t * e)
+{
+    lv_event_set_ext_draw_size(e, (int32_t)(lv_uintptr_t)lv_event_get_user_data(e));
+}
+
+lv_obj_t * ui_label_cache_create(lv_obj_t * parent, const char * text, const lv_font_t * font)
+{
+    ui_label_cache_entry_t * entry = ui_label_cache_get(text, font);
+    if(entry == NULL) {
+        lv_obj_t * label = lv_label_create(parent);
+        lv_label_set_text_static(label, text);
+        lv_obj_set_style_text_font(label, font, LV_PART_MAIN | LV_STATE_DEFAULT);
+        return label;
+    }
+
+    lv_obj_t * img = lv_image_create(parent);
+    lv_image_set_src(img, entry->buf);
+
+    // Same size (and so the same alignment) as the label, the overhang of
+    // the last glyph is drawn outside of it like the label does
+    int32_t overhang = entry->buf->header.w - entry->text_w;
+    if(overhang > 0) {
+        lv_obj_set_width(img, entry->text_w);
+        lv_image_set_inner_align(img, LV_IMAGE_ALIGN_TOP_LEFT);
+        lv_obj_add_event_cb(img, ui_label_cache_ext_draw_cb, LV_EVENT_REFR_EXT_DRAW_SIZE, (void *)(lv_uintptr_t)overhang);
+        lv_obj_refresh_ext_draw_size(img);
+    }
+
+    // A8 images are blended with the recolor color, so the same bitmap
+    // serves any text color
+    lv_obj_set_style_image_recolor(img, lv_obj_get_style_text_color(parent, LV_PART_MAIN), LV_PART_MAIN | LV_STATE_DEFAULT);
+    return img;
+}
+
+void ui_label_cache_clear(void)
+{
+    for(uint32_t i = 0; i < ui_label_cache_count; i++) {
+        lv_image_cache_drop(ui_label_cache[i].buf);
+        lv_draw_buf_destroy(ui_label_cache[i].buf);
+    }
+    ui_label_cache_count = 0;
+}
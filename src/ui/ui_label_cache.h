@@ -0,0 +1,32 @@
+#ifndef UI_LABEL_CACHE_H
+#define UI_LABEL_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ui.h"
+
+// Static labels drawn from a pre-rendered A8 bitmap instead of being
+// laid out and rasterized glyph by glyph on every redraw.
+// Build with -DUI_USE_LABEL_CACHE=1 to use it for the panel labels.
+#ifndef UI_USE_LABEL_CACHE
+#define UI_USE_LABEL_CACHE 0
+#endif
+
+#define UI_LABEL_CACHE_SIZE 16
+
+// Creates an image showing text in font, colored with the text color the
+// parent inherits. Identical text+font pairs share one bitmap, once the
+// cache is full a plain label is created instead.
+// text must stay valid (same rule as lv_label_set_text_static).
+lv_obj_t * ui_label_cache_create(lv_obj_t * parent, const char * text, const lv_font_t * font);
+
+// Frees every cached bitmap, the images using them must be deleted first
+void ui_label_cache_clear(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
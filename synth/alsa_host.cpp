@@ -0,0 +1,341 @@
+// Faust architecture file: drumkit.dsp straight on an ALSA hw device, no
+// sound server, built by `make synth-alsa`. Takes the OSC the controller
+// sends (see osc_control.h), plus the sequencer (sequencer.h)
+// and the DSP hot-swap (dsp_swap.h, /synth/load).
+//
+//   drumkit_alsa [-d device] [-p frames] [-n periods] [-r rate] [-R prio] [-P osc_port] [-a]
+//
+// -a takes OSC from other hosts, by default only this machine controls it.
+// The device is opened in mmap interleaved mode with two small periods
+// (64 frames by default). A SCHED_FIFO thread sleeps in snd_pcm_wait()
+// until a period interrupt frees room, runs compute() for that period
+// and writes it into the mmap area, so a sample is never more than
+// periods * frames old when it reaches the DAC. Works with snd-dummy
+// and snd-aloop (-d hw:Dummy or -d hw:Loopback,0) for testing.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <atomic>
+#include <alsa/asoundlib.h>
+
+#ifndef FAUSTFLOAT
+#define FAUSTFLOAT float
+#endif
+
+#include "faust/dsp/dsp.h"
+#include "faust/gui/meta.h"
+#include "faust/gui/UI.h"
+
+<<includeIntrinsic>>
+
+<<includeclass>>
+
+#include "osc_control.h"
+#include "sequencer.h"
+#include "dsp_swap.h"
+
+#define DEFAULT_DEVICE   "hw:0,0"
+#define DEFAULT_PERIOD   64
+#define DEFAULT_PERIODS  2
+#define DEFAULT_RATE     48000
+#define DEFAULT_PRIO     80
+
+#define MAX_OUTPUTS      8
+#define MAX_PERIOD       4096
+
+// Stack the audio thread touches up front, so it never faults it in
+#define PREFAULT_STACK   (64 * 1024)
+
+static mydsp DSP;
+
+static snd_pcm_t *pcm;
+static snd_pcm_format_t format;
+static unsigned rate;
+static unsigned channels;
+static snd_pcm_uframes_t period_frames;
+static snd_pcm_uframes_t buffer_frames;
+
+// compute() output of one period, interleaved into the mmap area
+static FAUSTFLOAT scratch[MAX_OUTPUTS][MAX_PERIOD];
+
+// Taken by the reporting loop once a second
+static std::atomic<unsigned> xruns(0);
+static std::atomic<unsigned> cycles(0);
+static std::atomic<uint64_t> busy_ns(0);
+static std::atomic<uint64_t> max_busy_ns(0);
+static std::atomic<long> delay_frames(0);
+
+static volatile sig_atomic_t running = 1;
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// Hardware formats in order of preference, the DSP is converted from float
+static const snd_pcm_format_t formats[] = {
+    SND_PCM_FORMAT_FLOAT_LE,
+    SND_PCM_FORMAT_S32_LE,
+    SND_PCM_FORMAT_S16_LE,
+};
+
+static int open_device(const char *device, unsigned want_rate, snd_pcm_uframes_t period, unsigned periods) {
+    int err = snd_pcm_open(&pcm, device, SND_PCM_STREAM_PLAYBACK, 0);
+    if (err < 0) {
+        fprintf(stderr, "%s: %s\n", device, snd_strerror(err));
+        return -1;
+    }
+
+    snd_pcm_hw_params_t *hw;
+    snd_pcm_hw_params_alloca(&hw);
+    snd_pcm_hw_params_any(pcm, hw);
+    // Only the real rates of the hardware, no plugin in between
+    snd_pcm_hw_params_set_rate_resample(pcm, hw, 0);
+    if ((err = snd_pcm_hw_params_set_access(pcm, hw, SND_PCM_ACCESS_MMAP_INTERLEAVED)) < 0) {
+        fprintf(stderr, "%s: no mmap interleaved access: %s\n", device, snd_strerror(err));
+        return -1;
+    }
+    size_t f = 0;
+    while (f < sizeof(formats) / sizeof(formats[0]) && snd_pcm_hw_params_set_format(pcm, hw, formats[f]) < 0) f++;
+    if (f == sizeof(formats) / sizeof(formats[0])) {
+        fprintf(stderr, "%s: no float, S32 or S16 format\n", device);
+        return -1;
+    }
+    format = formats[f];
+
+    channels = DSP.getNumOutputs();
+    if ((err = snd_pcm_hw_params_set_channels_near(pcm, hw, &channels)) < 0 ||
+        (err = snd_pcm_hw_params_set_rate_near(pcm, hw, &want_rate, NULL)) < 0 ||
+        (err = snd_pcm_hw_params_set_period_size_near(pcm, hw, &period, NULL)) < 0 ||
+        (err = snd_pcm_hw_params_set_periods_near(pcm, hw, &periods, NULL)) < 0 ||
+        (err = snd_pcm_hw_params(pcm, hw)) < 0) {
+        fprintf(stderr, "%s: hw params: %s\n", device, snd_strerror(err));
+        return -1;
+    }
+    rate = want_rate;
+    snd_pcm_hw_params_get_period_size(hw, &period_frames, NULL);
+    snd_pcm_hw_params_get_buffer_size(hw, &buffer_frames);
+    if (channels > MAX_OUTPUTS || period_frames > MAX_PERIOD) {
+        fprintf(stderr, "%s: %u channels, %lu frame periods not supported\n", device, channels, period_frames);
+        return -1;
+    }
+
+    // Woken once per period, started by hand once the buffer is primed
+    snd_pcm_sw_params_t *sw;
+    snd_pcm_sw_params_alloca(&sw);
+    snd_pcm_sw_params_current(pcm, sw);
+    snd_pcm_sw_params_set_avail_min(pcm, sw, period_frames);
+    snd_pcm_sw_params_set_start_threshold(pcm, sw, buffer_frames * 2);
+    if ((err = snd_pcm_sw_params(pcm, sw)) < 0) {
+        fprintf(stderr, "%s: sw params: %s\n", device, snd_strerror(err));
+        return -1;
+    }
+    return 0;
+}
+
+// The scratch period into the mmap area, converted to the device format
+static void write_area(const snd_pcm_channel_area_t *areas, snd_pcm_uframes_t offset, snd_pcm_uframes_t frames) {
+    int dsp_outputs = DSP.getNumOutputs();
+    for (unsigned c = 0; c < channels; c++) {
+        // Fewer DSP outputs than device channels: the last one is repeated
+        const FAUSTFLOAT *src = scratch[c < (unsigned)dsp_outputs ? c : dsp_outputs - 1];
+        const snd_pcm_channel_area_t *a = &areas[c];
+        char *base = (char *)a->addr + (a->first + offset * a->step) / 8;
+        int step = a->step / 8;
+
+        for (snd_pcm_uframes_t i = 0; i < frames; i++) {
+            float v = src[i];
+            if (v > 1.0f) v = 1.0f;
+            if (v < -1.0f) v = -1.0f;
+            char *dst = base + i * step;
+            if (format == SND_PCM_FORMAT_FLOAT_LE) *(float *)dst = v;
+            else if (format == SND_PCM_FORMAT_S32_LE) *(int32_t *)dst = (int32_t)(v * 2147483520.0f);
+            else *(int16_t *)dst = (int16_t)(v * 32767.0f);
+        }
+    }
+}
+
+// Fills every free frame, with silence (prime) or with DSP output
+static int fill(bool silence) {
+    snd_pcm_sframes_t avail = snd_pcm_avail_update(pcm);
+    if (avail < 0) return avail;
+
+    while ((snd_pcm_uframes_t)avail >= period_frames) {
+        const snd_pcm_channel_area_t *areas;
+        snd_pcm_uframes_t offset;
+        snd_pcm_uframes_t frames = period_frames;
+        int err = snd_pcm_mmap_begin(pcm, &areas, &offset, &frames);
+        if (err < 0) return err;
+
+        if (silence) {
+            snd_pcm_areas_silence(areas, offset, channels, frames, format);
+        } else {
+            uint64_t start = now_ns();
+            dsp_swap_begin();
+            osc_control_apply();
+            FAUSTFLOAT *outputs[MAX_OUTPUTS];
+            int n = DSP.getNumOutputs() < MAX_OUTPUTS ? DSP.getNumOutputs() : MAX_OUTPUTS;
+            for (int i = 0; i < n; i++) outputs[i] = scratch[i];
+            sequencer_compute(dsp_swap_compute, frames, outputs, n);
+            write_area(areas, offset, frames);
+
+            uint64_t busy = now_ns() - start;
+            busy_ns.fetch_add(busy, std::memory_order_relaxed);
+            if (busy > max_busy_ns.load(std::memory_order_relaxed)) {
+                max_busy_ns.store(busy, std::memory_order_relaxed);
+            }
+            cycles.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        snd_pcm_sframes_t done = snd_pcm_mmap_commit(pcm, offset, frames);
+        if (done < 0) return done;
+        if ((snd_pcm_uframes_t)done != frames) return -EPIPE;
+        avail -= frames;
+    }
+    return 0;
+}
+
+// Buffer full of silence, then running
+static int prime() {
+    int err = fill(true);
+    if (err < 0) return err;
+    return snd_pcm_start(pcm);
+}
+
+static void *audio_thread(void *) {
+    // Every page of the stack present before the first period
+    volatile char stack[PREFAULT_STACK];
+    memset((char *)stack, 0, sizeof(stack));
+
+    if (prime() < 0) {
+        fprintf(stderr, "Can not start the PCM\n");
+        running = 0;
+        return NULL;
+    }
+
+    while (running) {
+        // Period interrupt, or an xrun / suspend reported by the driver
+        int err = snd_pcm_wait(pcm, 1000);
+        if (err >= 0) err = fill(false);
+
+        if (err < 0) {
+            xruns.fetch_add(1, std::memory_order_relaxed);
+            if (snd_pcm_recover(pcm, err, 1) < 0 || prime() < 0) {
+                fprintf(stderr, "PCM lost: %s\n", snd_strerror(err));
+                running = 0;
+                break;
+            }
+            continue;
+        }
+
+        snd_pcm_sframes_t delay;
+        if (snd_pcm_delay(pcm, &delay) == 0) {
+            delay_frames.store(delay, std::memory_order_relaxed);
+        }
+    }
+    return NULL;
+}
+
+static void stop(int) {
+    running = 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *device = DEFAULT_DEVICE;
+    const char *osc_port = OSC_CONTROL_DEFAULT_PORT;
+    unsigned want_rate = DEFAULT_RATE;
+    snd_pcm_uframes_t period = DEFAULT_PERIOD;
+    unsigned periods = DEFAULT_PERIODS;
+    int prio = DEFAULT_PRIO;
+    bool any_host = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:p:n:r:R:P:a")) != -1) {
+        switch (opt) {
+        case 'd': device = optarg; break;
+        case 'p': period = atoi(optarg); break;
+        case 'n': periods = atoi(optarg); break;
+        case 'r': want_rate = atoi(optarg); break;
+        case 'R': prio = atoi(optarg); break;
+        case 'P': osc_port = optarg; break;
+        case 'a': any_host = true; break;
+        default:
+            fprintf(stderr, "usage: %s [-d device] [-p frames] [-n periods] [-r rate] [-R prio] [-P osc_port] [-a]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // No page faults once the audio thread runs
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        perror("mlockall");
+    }
+
+    if (open_device(device, want_rate, period, periods) < 0) {
+        return 1;
+    }
+    DSP.init(rate);
+    if (osc_control_start(&DSP, osc_port, any_host) < 0) {
+        return 1;
+    }
+    sequencer_start(rate);
+    dsp_swap_start(rate, DSP.getNumOutputs());
+    osc_control_listen();
+
+    pthread_attr_t attr;
+    struct sched_param sp;
+    sp.sched_priority = prio;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, PREFAULT_STACK + 256 * 1024);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    pthread_attr_setschedparam(&attr, &sp);
+
+    pthread_t thread;
+    if (pthread_create(&thread, &attr, audio_thread, NULL) != 0) {
+        // No CAP_SYS_NICE / rtprio limit: run anyway, the counters will tell
+        fprintf(stderr, "No SCHED_FIFO %d, running the audio thread at normal priority\n", prio);
+        pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        if (pthread_create(&thread, &attr, audio_thread, NULL) != 0) {
+            fprintf(stderr, "Can not start the audio thread\n");
+            return 1;
+        }
+    }
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    double period_ms = period_frames * 1000.0 / rate;
+    printf("%s: %s, %u ch, %u Hz, %lu x %lu frames (%.2f ms buffer), OSC on %s (%zu controls)\n", device,
+           snd_pcm_format_name(format), channels, rate, buffer_frames / period_frames, period_frames,
+           buffer_frames * 1000.0 / rate, osc_port, ctrl_ids.size());
+
+    // Once a second: DSP load against the period (mean and worst), output
+    // latency (frames queued in front of the DAC) and the xruns
+    while (running) {
+        sleep(1);
+
+        unsigned n = cycles.exchange(0);
+        uint64_t busy = busy_ns.exchange(0);
+        uint64_t worst = max_busy_ns.exchange(0);
+        unsigned x = xruns.exchange(0);
+        long delay = delay_frames.load();
+
+        printf("%u periods, DSP load %.1f%% mean %.1f%% max, latency %ld frames (%.2f ms), %u xruns\n", n,
+               n ? 100.0 * busy / n / (period_ms * 1e6) : 0.0, 100.0 * worst / (period_ms * 1e6), delay,
+               delay * 1000.0 / rate, x);
+        fflush(stdout);
+    }
+
+    pthread_join(thread, NULL);
+    osc_control_stop();
+    snd_pcm_close(pcm);
+    return 0;
+}
@@ -0,0 +1,358 @@
+// Runtime replacement of the DSP for the synth hosts in this directory,
+// without dropping audio or the OSC port:
+//
+//   /synth/load s    a drumkit.dsp variant built by `make synth-plugin`
+//                    (.so), or a .dsp compiled on the spot by
+//                    scripts/dsp_plugin.sh ($DRUMKIT_DSP_BUILD names
+//                    another program taking the same two arguments).
+//                    Any other path is refused, and so is a variant
+//                    without the hit controls (/drumkit/<Sound>,
+//                    SEQ_HIT_PREFIX<Sound>, REC_HIT_PREFIX<Sound>)
+//
+// A loader thread compiles / dlopens the variant, runs init() and binds
+// its controls (osc_control.h), copying the current parameter values over,
+// all off the audio thread. The slot is then handed over through an
+// atomic: the audio thread takes it at the start of a cycle and crossfades
+// from the old DSP over SWAP_FADE_MS, computing both, without allocating
+// or locking. The old DSP goes back to the loader to be freed. The loader
+// reports the compile and load times and the swap latency (hand over to
+// first block), plus the fade.
+// Needs osc_control.h included first
+
+#ifndef DSP_SWAP_H
+#define DSP_SWAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dlfcn.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#include <atomic>
+#include <string>
+
+#include "sounds.h"
+#include "seq_patterns.h"
+#include "recorder.h"
+
+#define SWAP_FADE_MS          10
+#define SWAP_MAX_OUTPUTS      8
+#define SWAP_MAX_BLOCK        1024
+// Waits this long for the audio thread to take a DSP before giving up
+#define SWAP_TIMEOUT_MS       2000
+#define SWAP_DEFAULT_BUILD    "scripts/dsp_plugin.sh"
+// Factory a plugin exports (synth/plugin.cpp)
+#define SWAP_FACTORY          "drumkit_create"
+
+typedef dsp *(*DspFactory)();
+
+// Hit controls of a sound, + its name: pads, sequencer steps, replay
+#define SWAP_HIT_WRITERS 3
+static const char *const swap_hit_prefixes[SWAP_HIT_WRITERS] = {"/drumkit/", SEQ_HIT_PREFIX, REC_HIT_PREFIX};
+
+static int swap_rate;
+static int swap_outputs;
+
+// Audio thread: output of the DSP fading out, and the fade position
+static FAUSTFLOAT swap_scratch[SWAP_MAX_OUTPUTS][SWAP_MAX_BLOCK];
+static int swap_fade_len;
+static int swap_fade_pos;
+
+// Loader -> audio thread: the next DSP, and audio -> loader: the old one
+static std::atomic<DspSlot *> swap_next(NULL);
+static std::atomic<DspSlot *> swap_done(NULL);
+static std::atomic<uint64_t> swap_take_ns(0);
+
+// /synth/load -> loader thread. Plain pthread objects: nothing to destroy
+// at exit while the loader still waits
+static pthread_mutex_t swap_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t swap_wake = PTHREAD_COND_INITIALIZER;
+static std::string swap_request;
+
+// Loader thread: the slot it handed over last
+static DspSlot *swap_current = &ctrl_builtin;
+
+// Directory of the libraries about to be dlopen'ed, made by mkdtemp and
+// only open to this user: no one else can put a file or link there
+static char swap_dir[] = "/tmp/drumkit_swap_XXXXXX";
+
+static uint64_t swap_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// Audio thread, at the start of a cycle before osc_control_apply: takes a
+// waiting DSP unless a fade still runs
+static inline void dsp_swap_begin() {
+    if (ctrl_fading != NULL || swap_next.load(std::memory_order_relaxed) == NULL) return;
+
+    ctrl_fading = ctrl_live;
+    ctrl_live = swap_next.exchange(NULL, std::memory_order_acquire);
+    swap_fade_pos = 0;
+    swap_take_ns.store(swap_now_ns(), std::memory_order_relaxed);
+}
+
+// Audio thread: compute() of the live DSP, mixed with the one fading out
+static void dsp_swap_compute(int frames, FAUSTFLOAT **outputs) {
+    ctrl_live->d->compute(frames, NULL, outputs);
+    if (ctrl_fading == NULL) return;
+
+    FAUSTFLOAT *old[SWAP_MAX_OUTPUTS];
+    for (int pos = 0; pos < frames && ctrl_fading != NULL;) {
+        int n = frames - pos < SWAP_MAX_BLOCK ? frames - pos : SWAP_MAX_BLOCK;
+        for (int c = 0; c < swap_outputs; c++) old[c] = swap_scratch[c];
+        ctrl_fading->d->compute(n, NULL, old);
+
+        int fade = swap_fade_len - swap_fade_pos < n ? swap_fade_len - swap_fade_pos : n;
+        for (int c = 0; c < swap_outputs; c++) {
+            FAUSTFLOAT *out = outputs[c] + pos;
+            for (int i = 0; i < fade; i++) {
+                float g = (float)(swap_fade_pos + i) / swap_fade_len;
+                out[i] = g * out[i] + (1.0f - g) * old[c][i];
+            }
+        }
+        swap_fade_pos += fade;
+        pos += n;
+        if (swap_fade_pos == swap_fade_len) {
+            swap_done.store(ctrl_fading, std::memory_order_release);
+            ctrl_fading = NULL;
+        }
+    }
+}
+
+static void swap_free(DspSlot *slot) {
+    if (slot == &ctrl_builtin) return;
+    delete slot->d;
+    dlclose(slot->handle);
+    delete slot;
+}
+
+static bool swap_has_suffix(const char *path, const char *suffix) {
+    size_t len = strlen(path), n = strlen(suffix);
+    return len > n && strcmp(path + len - n, suffix) == 0;
+}
+
+// Runs a program with its arguments, no shell between the path of an
+// OSC message and the command line. 0 once it exited with 0
+static int swap_run(const char *const argv[]) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0) {
+        execvp(argv[0], (char *const *)argv);
+        _exit(127);
+    }
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "%s %s %s failed (%s %d)\n", argv[0], argv[1], argv[2],
+                WIFEXITED(status) ? "exit" : "signal", WIFEXITED(status) ? WEXITSTATUS(status) : WTERMSIG(status));
+        return -1;
+    }
+    return 0;
+}
+
+// A new name in swap_dir for every library dlopen'ed: given a path it
+// already loaded, dlopen hands back that library, not the file rebuilt since
+static std::string swap_temp_so() {
+    static int loads;
+    char so[64];
+    snprintf(so, sizeof(so), "%s/%d.so", swap_dir, ++loads);
+    return so;
+}
+
+// Runs the build program on a .dsp. Empty on failure
+static std::string swap_compile(const std::string &path, double *ms) {
+    const char *build = getenv("DRUMKIT_DSP_BUILD");
+    std::string so = swap_temp_so();
+    const char *argv[] = {build ? build : SWAP_DEFAULT_BUILD, path.c_str(), so.c_str(), NULL};
+
+    uint64_t start = swap_now_ns();
+    int status = swap_run(argv);
+    *ms = (swap_now_ns() - start) / 1e6;
+    return status == 0 ? so : "";
+}
+
+// A built .so under a new name. Empty on failure
+static std::string swap_copy(const std::string &path) {
+    std::string so = swap_temp_so();
+    FILE *in = fopen(path.c_str(), "rb");
+    int fd = in != NULL ? open(so.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0600) : -1;
+    FILE *out = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if (out == NULL && fd >= 0) close(fd);
+    bool ok = out != NULL;
+    char buf[65536];
+    size_t n;
+    while (ok && (n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        ok = fwrite(buf, 1, n, out) == n;
+    }
+    ok = ok && !ferror(in);
+    if (out != NULL && fclose(out) != 0) ok = false;
+    if (in != NULL) fclose(in);
+    if (!ok) {
+        perror(path.c_str());
+        unlink(so.c_str());
+        return "";
+    }
+    return so;
+}
+
+// A slot for the plugin so, built from path, bound and carrying the
+// current parameters. NULL on error
+static DspSlot *swap_load(const std::string &path, const std::string &so) {
+    void *handle = dlopen(so.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == NULL) {
+        fprintf(stderr, "%s\n", dlerror());
+        return NULL;
+    }
+    DspFactory create = (DspFactory)dlsym(handle, SWAP_FACTORY);
+    dsp *d = create ? create() : NULL;
+    if (d == NULL || d->getNumInputs() != 0 || d->getNumOutputs() != swap_outputs) {
+        fprintf(stderr, "%s: no %s() or not a %d output DSP\n", path.c_str(), SWAP_FACTORY, swap_outputs);
+        delete d;
+        dlclose(handle);
+        return NULL;
+    }
+    d->init(swap_rate);
+
+    DspSlot *slot = new DspSlot;
+    slot->handle = handle;
+    osc_control_bind(slot, d);
+
+    // No hit controls of the controller, the sequencer or a replay
+    // (another declare name, other labels): it would play nothing
+    int hit_ids[SWAP_HIT_WRITERS * SOUND_COUNT];
+    for (int h = 0; h < SWAP_HIT_WRITERS * SOUND_COUNT; h++) {
+        hit_ids[h] = osc_control_find(std::string(swap_hit_prefixes[h % SWAP_HIT_WRITERS]) +
+                                      sound_names[h / SWAP_HIT_WRITERS]);
+    }
+    for (int h = 0; h < SWAP_HIT_WRITERS * SOUND_COUNT; h++) {
+        if (hit_ids[h] < 0 || slot->zones[hit_ids[h]] == NULL) {
+            fprintf(stderr, "%s: no %s%s hit control\n", path.c_str(), swap_hit_prefixes[h % SWAP_HIT_WRITERS],
+                    sound_names[h / SWAP_HIT_WRITERS]);
+            delete slot;
+            delete d;
+            dlclose(handle);
+            return NULL;
+        }
+    }
+
+    // The parameters keep their values (a change racing with the swap
+    // may be lost), the hit sliders stay at rest: a copied hit value
+    // would be a change, a hit, on the first sample. Every writer's alike
+    for (int id = 0; id < OSC_CONTROL_MAX; id++) {
+        bool hit = false;
+        for (int h = 0; h < SWAP_HIT_WRITERS * SOUND_COUNT; h++) hit |= hit_ids[h] == id;
+        if (!hit && slot->zones[id] != NULL && swap_current->zones[id] != NULL) {
+            *slot->zones[id] = *swap_current->zones[id];
+        }
+    }
+    return slot;
+}
+
+static void swap_one(const std::string &path) {
+    double compile_ms = 0;
+    bool dsp = swap_has_suffix(path.c_str(), ".dsp");
+    std::string so = dsp ? swap_compile(path, &compile_ms) : "";
+
+    // The copy of a .so counts as loading
+    uint64_t start = swap_now_ns();
+    if (!dsp) so = swap_copy(path);
+    if (so.empty()) return;
+
+    DspSlot *slot = swap_load(path, so);
+    unlink(so.c_str());     // stays mapped
+    if (slot == NULL) return;
+    double load_ms = (swap_now_ns() - start) / 1e6;
+
+    uint64_t handed = swap_now_ns();
+    swap_next.store(slot, std::memory_order_release);
+
+    // Taken and faded in: the old one comes back
+    DspSlot *old = NULL;
+    for (int ms = 0; old == NULL; ms++) {
+        if (ms == SWAP_TIMEOUT_MS) {
+            // Audio stopped: take the slot back if it is still waiting,
+            // else it was taken meanwhile and the fade runs
+            DspSlot *expected = slot;
+            if (swap_next.compare_exchange_strong(expected, NULL)) {
+                fprintf(stderr, "%s not swapped in, the audio thread is not running\n", path.c_str());
+                swap_free(slot);
+                return;
+            }
+        }
+        usleep(1000);
+        old = swap_done.exchange(NULL, std::memory_order_acquire);
+    }
+    swap_current = slot;
+    swap_free(old);
+
+    printf("swapped in %s: compile %.1f ms, load %.1f ms, swap after %.2f ms + %d ms crossfade\n", path.c_str(),
+           compile_ms, load_ms, (swap_take_ns.load() - handed) / 1e6, SWAP_FADE_MS);
+    fflush(stdout);
+}
+
+static void swap_remove_dir() {
+    rmdir(swap_dir);
+}
+
+static void *swap_thread(void *) {
+    for (;;) {
+        std::string path;
+        pthread_mutex_lock(&swap_lock);
+        while (swap_request.empty()) pthread_cond_wait(&swap_wake, &swap_lock);
+        path.swap(swap_request);
+        pthread_mutex_unlock(&swap_lock);
+        swap_one(path);
+    }
+    return NULL;
+}
+
+// The last request wins when several arrive during one load
+static int swap_load_message(const char *, const char *, lo_arg **argv, int, lo_message, void *) {
+    const char *path = &argv[0]->s;
+    // No option for the build program in place of a file
+    if (path[0] == '-' || !(swap_has_suffix(path, ".dsp") || swap_has_suffix(path, ".so"))) {
+        fprintf(stderr, "/synth/load %s refused, a .dsp or .so path is needed\n", path);
+        return 0;
+    }
+    pthread_mutex_lock(&swap_lock);
+    swap_request = path;
+    pthread_cond_signal(&swap_wake);
+    pthread_mutex_unlock(&swap_lock);
+    return 0;
+}
+
+// Loader thread and /synth/load, before osc_control_listen. outputs is
+// the output count every variant must have
+static void dsp_swap_start(int rate, int outputs) {
+    swap_rate = rate;
+    swap_outputs = outputs < SWAP_MAX_OUTPUTS ? outputs : SWAP_MAX_OUTPUTS;
+    swap_fade_len = rate * SWAP_FADE_MS / 1000;
+
+    if (mkdtemp(swap_dir) == NULL) {
+        perror(swap_dir);
+        fprintf(stderr, "No directory for the DSP builds, /synth/load disabled\n");
+        return;
+    }
+    atexit(swap_remove_dir);
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, swap_thread, NULL) != 0) {
+        fprintf(stderr, "No DSP loader thread, /synth/load disabled\n");
+        return;
+    }
+    pthread_detach(thread);
+    lo_server_thread_add_method(osc_thread, "/synth/load", "s", swap_load_message, NULL);
+}
+
+#endif
@@ -0,0 +1,189 @@
+// Faust architecture file: drumkit.dsp as a JACK client, built by
+// `make synth`. Takes the OSC the controller sends (src/trigger_osc.c,
+// /drumkit/<label> f on port 5510), with the period size, the process
+// callback and the xrun / DSP load reporting under our control. The
+// metronome / pattern sequencer (sequencer.h) runs in the process callback,
+// and /synth/load swaps in a drumkit.dsp variant while it plays (dsp_swap.h).
+//
+//   drumkit_jack [-p frames] [-P osc_port] [-a] [-n client_name] [-c]
+//
+// -p asks the JACK server for that period (64, 32, ...), -c leaves the
+// outputs unconnected instead of connecting them to system:playback_*,
+// -a takes OSC from other hosts (this machine only by default)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <atomic>
+#include <jack/jack.h>
+
+#ifndef FAUSTFLOAT
+#define FAUSTFLOAT float
+#endif
+
+#include "faust/dsp/dsp.h"
+#include "faust/gui/meta.h"
+#include "faust/gui/UI.h"
+
+<<includeIntrinsic>>
+
+<<includeclass>>
+
+#include "osc_control.h"
+#include "sequencer.h"
+#include "dsp_swap.h"
+
+#define MAX_OUTPUTS      8
+
+static mydsp DSP;
+
+static jack_client_t *client;
+static jack_port_t *out_ports[MAX_OUTPUTS];
+static int num_outputs;
+
+// Per cycle figures, taken by the reporting loop once a second
+static std::atomic<unsigned> xruns(0);
+static std::atomic<unsigned> cycles(0);
+static std::atomic<uint64_t> busy_ns(0);
+static std::atomic<uint64_t> max_busy_ns(0);
+
+static volatile sig_atomic_t running = 1;
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int process(jack_nframes_t nframes, void *) {
+    uint64_t start = now_ns();
+
+    dsp_swap_begin();
+    osc_control_apply();
+
+    FAUSTFLOAT *outputs[MAX_OUTPUTS];
+    for (int i = 0; i < num_outputs; i++) {
+        outputs[i] = (FAUSTFLOAT *)jack_port_get_buffer(out_ports[i], nframes);
+    }
+    sequencer_compute(dsp_swap_compute, nframes, outputs, num_outputs);
+
+    uint64_t busy = now_ns() - start;
+    busy_ns.fetch_add(busy, std::memory_order_relaxed);
+    if (busy > max_busy_ns.load(std::memory_order_relaxed)) {
+        max_busy_ns.store(busy, std::memory_order_relaxed);
+    }
+    cycles.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+}
+
+static int xrun(void *) {
+    xruns.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+}
+
+static void stop(int) {
+    running = 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = "drumkit";
+    const char *osc_port = OSC_CONTROL_DEFAULT_PORT;
+    int period = 0;
+    bool connect = true;
+    bool any_host = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:P:an:c")) != -1) {
+        switch (opt) {
+        case 'p': period = atoi(optarg); break;
+        case 'P': osc_port = optarg; break;
+        case 'a': any_host = true; break;
+        case 'n': name = optarg; break;
+        case 'c': connect = false; break;
+        default:
+            fprintf(stderr, "usage: %s [-p frames] [-P osc_port] [-a] [-n client_name] [-c]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // No page faults in the process callback
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        perror("mlockall");
+    }
+
+    jack_status_t status;
+    client = jack_client_open(name, JackNoStartServer, &status);
+    if (client == NULL) {
+        fprintf(stderr, "Can not connect to the JACK server (status 0x%x)\n", status);
+        return 1;
+    }
+    if (period > 0 && jack_set_buffer_size(client, period) != 0) {
+        fprintf(stderr, "JACK refused a period of %d frames\n", period);
+    }
+
+    DSP.init(jack_get_sample_rate(client));
+
+    num_outputs = DSP.getNumOutputs();
+    if (num_outputs > MAX_OUTPUTS) num_outputs = MAX_OUTPUTS;
+    for (int i = 0; i < num_outputs; i++) {
+        char port_name[16];
+        snprintf(port_name, sizeof(port_name), "out_%d", i + 1);
+        out_ports[i] = jack_port_register(client, port_name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+    }
+
+    jack_set_process_callback(client, process, NULL);
+    jack_set_xrun_callback(client, xrun, NULL);
+
+    // Controls bound before the process callback can run
+    if (osc_control_start(&DSP, osc_port, any_host) < 0) {
+        return 1;
+    }
+    sequencer_start(jack_get_sample_rate(client));
+    dsp_swap_start(jack_get_sample_rate(client), num_outputs);
+
+    if (jack_activate(client) != 0) {
+        fprintf(stderr, "Can not activate the JACK client\n");
+        return 1;
+    }
+    osc_control_listen();
+
+    if (connect) {
+        const char **playback = jack_get_ports(client, NULL, NULL, JackPortIsPhysical | JackPortIsInput);
+        for (int i = 0; playback != NULL && playback[i] != NULL && i < num_outputs; i++) {
+            jack_connect(client, jack_port_name(out_ports[i]), playback[i]);
+        }
+        jack_free(playback);
+    }
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    jack_nframes_t rate = jack_get_sample_rate(client);
+    printf("%s: %d outputs, %u Hz, period %u frames, OSC on %s (%zu controls)\n", name, num_outputs, rate,
+           jack_get_buffer_size(client), osc_port, ctrl_ids.size());
+
+    // Once a second: DSP load of the process callback against the period
+    // (mean and worst cycle), JACK's own estimate and the xruns
+    while (running) {
+        sleep(1);
+
+        unsigned n = cycles.exchange(0);
+        uint64_t busy = busy_ns.exchange(0);
+        uint64_t worst = max_busy_ns.exchange(0);
+        unsigned x = xruns.exchange(0);
+        double period_ns = jack_get_buffer_size(client) * 1e9 / rate;
+
+        printf("period %u: %u cycles, DSP load %.1f%% mean %.1f%% max, JACK %.1f%%, %u xruns\n",
+               jack_get_buffer_size(client), n, n ? 100.0 * busy / n / period_ns : 0.0,
+               100.0 * worst / period_ns, jack_cpu_load(client), x);
+        fflush(stdout);
+    }
+
+    osc_control_stop();
+    jack_client_close(client);
+    return 0;
+}
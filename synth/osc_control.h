@@ -0,0 +1,172 @@
+// OSC control of a Faust DSP for the synth hosts in this directory: the
+// /<dsp name>/<label> f interface of faust's own OSC architecture.
+// Changes are queued by the liblo thread and applied by the audio thread
+// at the start of a cycle (osc_control_apply), so every message of a
+// bundle lands in the same block and the audio thread never locks.
+//
+// A control is known by an id that stays the same whatever DSP plays:
+// every DSP gets a DspSlot with its zone of each id, so the queue and the
+// sequencer survive a swap (dsp_swap.h) and a crossfade writes both DSPs.
+//
+// liblo listens on every interface and cannot bind one address, so
+// messages from other machines are dropped before any method sees them
+// unless the host was started to take them (-a): /synth/load runs a
+// compiler and loads code.
+// Needs FAUSTFLOAT and faust/gui/UI.h included first
+
+#ifndef OSC_CONTROL_H
+#define OSC_CONTROL_H
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <lo/lo.h>
+
+#include "path_ui.h"
+
+#define OSC_CONTROL_DEFAULT_PORT "5510"
+#define OSC_CONTROL_QUEUE_SIZE   256
+// Distinct control paths over every DSP loaded
+#define OSC_CONTROL_MAX          256
+
+struct CtrlChange {
+    int id;
+    FAUSTFLOAT value;
+};
+
+// A DSP and its zone of every control id, NULL for the ids it lacks
+struct DspSlot {
+    dsp *d;
+    void *handle;       // dlopen handle, NULL for the DSP built into the host
+    FAUSTFLOAT *zones[OSC_CONTROL_MAX];
+};
+
+// Control ids by path, shared by the liblo thread and the DSP loader
+static std::map<std::string, int> ctrl_ids;
+static std::mutex ctrl_ids_lock;
+
+static CtrlChange ctrl_queue[OSC_CONTROL_QUEUE_SIZE];
+static std::atomic<unsigned> ctrl_head(0);  // written by the OSC thread
+static std::atomic<unsigned> ctrl_tail(0);  // written by the audio thread
+static lo_server_thread osc_thread;
+
+// Audio thread: the DSP playing, and the one fading out after a swap
+static DspSlot ctrl_builtin;
+static DspSlot *ctrl_live = &ctrl_builtin;
+static DspSlot *ctrl_fading;
+
+// Id of path, -1 if no DSP loaded so far has it
+static int osc_control_find(const std::string &path) {
+    std::lock_guard<std::mutex> lock(ctrl_ids_lock);
+    std::map<std::string, int>::iterator it = ctrl_ids.find(path);
+    return it == ctrl_ids.end() ? -1 : it->second;
+}
+
+// Fills slot with the zones of d, new paths get new ids. Not on the audio thread
+static void osc_control_bind(DspSlot *slot, dsp *d) {
+    PathUI paths;
+    d->buildUserInterface(&paths);
+
+    std::lock_guard<std::mutex> lock(ctrl_ids_lock);
+    slot->d = d;
+    for (int id = 0; id < OSC_CONTROL_MAX; id++) slot->zones[id] = NULL;
+    for (std::map<std::string, FAUSTFLOAT *>::iterator it = paths.zones.begin(); it != paths.zones.end(); ++it) {
+        std::map<std::string, int>::iterator known = ctrl_ids.find(it->first);
+        int id;
+        if (known != ctrl_ids.end()) {
+            id = known->second;
+        } else if (ctrl_ids.size() < OSC_CONTROL_MAX) {
+            id = (int)ctrl_ids.size();
+            ctrl_ids[it->first] = id;
+        } else {
+            fprintf(stderr, "more than %d controls, %s left out\n", OSC_CONTROL_MAX, it->first.c_str());
+            continue;
+        }
+        slot->zones[id] = it->second;
+    }
+}
+
+// Audio thread: a control of the live DSP, and of the one fading out
+static inline void osc_control_write(int id, FAUSTFLOAT value) {
+    if (ctrl_live->zones[id] != NULL) *ctrl_live->zones[id] = value;
+    if (ctrl_fading != NULL && ctrl_fading->zones[id] != NULL) *ctrl_fading->zones[id] = value;
+}
+
+// Audio thread, before compute()
+static inline void osc_control_apply() {
+    unsigned tail = ctrl_tail.load(std::memory_order_relaxed);
+    unsigned head = ctrl_head.load(std::memory_order_acquire);
+    for (; tail != head; tail++) {
+        const CtrlChange &c = ctrl_queue[tail % OSC_CONTROL_QUEUE_SIZE];
+        osc_control_write(c.id, c.value);
+    }
+    ctrl_tail.store(tail, std::memory_order_release);
+}
+
+// /drumkit/<label> f: queued for the next cycle, dropped if the queue is full
+static int osc_control_message(const char *path, const char *types, lo_arg **argv, int argc, lo_message, void *) {
+    int id = osc_control_find(path);
+    if (id < 0) {
+        return 1;
+    }
+    unsigned head = ctrl_head.load(std::memory_order_relaxed);
+    if (head - ctrl_tail.load(std::memory_order_acquire) >= OSC_CONTROL_QUEUE_SIZE) {
+        fprintf(stderr, "control queue full, %s dropped\n", path);
+        return 0;
+    }
+    ctrl_queue[head % OSC_CONTROL_QUEUE_SIZE].id = id;
+    ctrl_queue[head % OSC_CONTROL_QUEUE_SIZE].value = argv[0]->f;
+    ctrl_head.store(head + 1, std::memory_order_release);
+    return 0;
+}
+
+// First method of the server: 0 stops the dispatch of a message sent from
+// another machine, 1 passes it on to the others
+static int osc_control_guard(const char *path, const char *, lo_arg **, int, lo_message msg, void *) {
+    static bool warned;
+    lo_address from = lo_message_get_source(msg);
+    const char *host = from != NULL ? lo_address_get_hostname(from) : NULL;
+    if (host != NULL && (strncmp(host, "127.", 4) == 0 || strcmp(host, "::1") == 0 ||
+                         strncmp(host, "::ffff:127.", 11) == 0)) {
+        return 1;
+    }
+    if (!warned) {
+        fprintf(stderr, "OSC from %s dropped (%s), -a takes messages from other hosts\n", host ? host : "?", path);
+        warned = true;
+    }
+    return 0;
+}
+
+static void osc_control_error(int num, const char *msg, const char *path) {
+    fprintf(stderr, "OSC error %d: %s %s\n", num, msg, path ? path : "");
+}
+
+// Collects the controls of the DSP built into the host and opens the
+// port, -1 if it is taken. any_host takes messages from other machines
+// too. Before the audio thread starts. More methods (sequencer.h,
+// dsp_swap.h) can be added to osc_thread until osc_control_listen
+static int osc_control_start(dsp *d, const char *port, bool any_host) {
+    osc_control_bind(&ctrl_builtin, d);
+
+    osc_thread = lo_server_thread_new(port, osc_control_error);
+    if (osc_thread == NULL) {
+        fprintf(stderr, "Can not listen on OSC port %s\n", port);
+        return -1;
+    }
+    if (!any_host) {
+        lo_server_thread_add_method(osc_thread, NULL, NULL, osc_control_guard, NULL);
+    }
+    lo_server_thread_add_method(osc_thread, NULL, "f", osc_control_message, NULL);
+    return 0;
+}
+
+static void osc_control_listen() {
+    lo_server_thread_start(osc_thread);
+}
+
+static void osc_control_stop() {
+    lo_server_thread_free(osc_thread);
+}
+
+#endif
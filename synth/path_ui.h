@@ -0,0 +1,41 @@
+// Zones of the controls of a Faust DSP by their OSC path, for the synth
+// hosts and tools in this directory. Needs FAUSTFLOAT and faust/gui/UI.h
+// included first
+
+#ifndef PATH_UI_H
+#define PATH_UI_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Zone of every control by OSC path, /<dsp name>/<label> like Faust's OSCUI
+class PathUI : public UI {
+    std::vector<std::string> groups;
+
+    void add(const char *label, FAUSTFLOAT *zone) {
+        std::string path;
+        for (size_t i = 0; i < groups.size(); i++) path += "/" + groups[i];
+        zones[path + "/" + label] = zone;
+    }
+
+public:
+    std::map<std::string, FAUSTFLOAT *> zones;
+
+    void openTabBox(const char *label) { groups.push_back(label); }
+    void openHorizontalBox(const char *label) { groups.push_back(label); }
+    void openVerticalBox(const char *label) { groups.push_back(label); }
+    void closeBox() { groups.pop_back(); }
+
+    void addButton(const char *label, FAUSTFLOAT *zone) { add(label, zone); }
+    void addCheckButton(const char *label, FAUSTFLOAT *zone) { add(label, zone); }
+    void addVerticalSlider(const char *label, FAUSTFLOAT *zone, FAUSTFLOAT, FAUSTFLOAT, FAUSTFLOAT, FAUSTFLOAT) { add(label, zone); }
+    void addHorizontalSlider(const char *label, FAUSTFLOAT *zone, FAUSTFLOAT, FAUSTFLOAT, FAUSTFLOAT, FAUSTFLOAT) { add(label, zone); }
+    void addNumEntry(const char *label, FAUSTFLOAT *zone, FAUSTFLOAT, FAUSTFLOAT, FAUSTFLOAT, FAUSTFLOAT) { add(label, zone); }
+
+    void addHorizontalBargraph(const char *, FAUSTFLOAT *, FAUSTFLOAT, FAUSTFLOAT) {}
+    void addVerticalBargraph(const char *, FAUSTFLOAT *, FAUSTFLOAT, FAUSTFLOAT) {}
+    void addSoundfile(const char *, const char *, Soundfile **) {}
+};
+
+#endif
@@ -0,0 +1,22 @@
+// Faust architecture file: a drumkit.dsp variant as a shared object that
+// a running synth host swaps in (dsp_swap.h, /synth/load). Built by
+// scripts/dsp_plugin.sh with -cn so the class does not clash with the
+// host's own mydsp, only the factory is exported.
+
+#include <math.h>
+
+#ifndef FAUSTFLOAT
+#define FAUSTFLOAT float
+#endif
+
+#include "faust/dsp/dsp.h"
+#include "faust/gui/meta.h"
+#include "faust/gui/UI.h"
+
+<<includeIntrinsic>>
+
+<<includeclass>>
+
+extern "C" __attribute__((visibility("default"))) dsp *drumkit_create() {
+    return new FAUSTCLASS();
+}
@@ -0,0 +1,254 @@
+// Faust architecture file: renders a trigger recording (DRUM_RECORD,
+// src/recorder.h) through drumkit.dsp into a WAV file as fast as the CPU
+// goes, built by `make synth-render`. A throughput benchmark for the DSP
+// and a bit-exact reference of its sound across builds.
+//
+//   drumkit_render [-r rate] [-b frames] [-t tail_s] [-l loops] [-i] rec_file [out.wav]
+//
+// Every hit lands on its exact sample: the block is cut at the hit and
+// the hit slider changes before the part after it, with the value the
+// OSC output sends (sound_hit_value, counting from 0). Sessions of the
+// file follow each other like in tools/replay.c. The WAV is 32 bit float
+// (-i for 16 bit), the report ends with a hash of the float samples that
+// stays the same as long as the sound does, whatever -b is.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <vector>
+
+#ifndef FAUSTFLOAT
+#define FAUSTFLOAT float
+#endif
+
+#include "faust/dsp/dsp.h"
+#include "faust/gui/meta.h"
+#include "faust/gui/UI.h"
+
+<<includeIntrinsic>>
+
+<<includeclass>>
+
+#include "path_ui.h"
+#include "recorder.h"
+#include "sounds.h"
+
+#define MAX_OUTPUTS          8
+#define MAX_BLOCK            4096
+#define SESSION_PAUSE_MS     500
+
+struct Hit {
+    uint64_t sample;
+    int sound;
+    float velocity;
+};
+
+static mydsp DSP;
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// The hits of the file at their sample, lead-ins of the sessions left out
+static bool load_hits(const char *path, int rate, std::vector<Hit> &hits) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+    RecHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, REC_MAGIC, sizeof(REC_MAGIC)) != 0 ||
+        header.version != REC_VERSION || header.event_size != sizeof(RecEvent)) {
+        fprintf(stderr, "%s is not a version %d trigger recording\n", path, REC_VERSION);
+        fclose(f);
+        return false;
+    }
+
+    uint64_t t_ns = 0;
+    bool lead_in = true;
+    RecEvent ev;
+    while (fread(&ev, sizeof(ev), 1, f) == 1) {
+        if (ev.flags & REC_FLAG_SESSION) {
+            lead_in = true;
+            continue;
+        }
+        if (lead_in) {
+            if (ev.flags & REC_FLAG_GAP) continue;
+            if (!hits.empty()) t_ns += SESSION_PAUSE_MS * 1000000ull;
+            lead_in = false;
+        } else {
+            t_ns += ev.delta_us * 1000ull;
+            if (ev.flags & REC_FLAG_GAP) continue;
+        }
+        if (ev.sound >= SOUND_COUNT) continue;
+
+        Hit hit = {(t_ns * rate + 500000000ull) / 1000000000ull, ev.sound, ev.velocity / 255.0f};
+        hits.push_back(hit);
+    }
+    fclose(f);
+    return true;
+}
+
+static void put16(FILE *f, uint16_t v) {
+    fputc(v & 0xff, f);
+    fputc(v >> 8, f);
+}
+
+static void put32(FILE *f, uint32_t v) {
+    put16(f, v & 0xffff);
+    put16(f, v >> 16);
+}
+
+// RIFF header, the length is known before the first sample
+static void wav_header(FILE *f, int channels, int rate, bool pcm16, uint32_t data_bytes) {
+    int bytes = pcm16 ? 2 : 4;
+    fwrite("RIFF", 1, 4, f);
+    put32(f, 36 + data_bytes);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put32(f, 16);
+    put16(f, pcm16 ? 1 : 3);    // PCM or IEEE float
+    put16(f, channels);
+    put32(f, rate);
+    put32(f, rate * channels * bytes);
+    put16(f, channels * bytes);
+    put16(f, bytes * 8);
+    fwrite("data", 1, 4, f);
+    put32(f, data_bytes);
+}
+
+int main(int argc, char *argv[]) {
+    int rate = 48000;
+    int block = 64;
+    double tail = 1.0;
+    int loops = 1;
+    bool pcm16 = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:b:t:l:i")) != -1) {
+        switch (opt) {
+        case 'r': rate = atoi(optarg); break;
+        case 'b': block = atoi(optarg); break;
+        case 't': tail = atof(optarg); break;
+        case 'l': loops = atoi(optarg); break;
+        case 'i': pcm16 = true; break;
+        default:
+            optind = argc + 1;
+        }
+    }
+    if (optind >= argc || optind + 2 < argc || rate <= 0 || block <= 0 || block > MAX_BLOCK || loops <= 0) {
+        fprintf(stderr, "usage: %s [-r rate] [-b frames] [-t tail_s] [-l loops] [-i] rec_file [out.wav]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Hit> hits;
+    if (!load_hits(argv[optind], rate, hits)) {
+        return 1;
+    }
+    // Loops back to back, the next one a tail after the last hit
+    uint64_t tail_frames = (uint64_t)(tail * rate);
+    uint64_t loop_frames = (hits.empty() ? 0 : hits.back().sample) + tail_frames;
+    size_t per_loop = hits.size();
+    for (int l = 1; l < loops; l++) {
+        for (size_t i = 0; i < per_loop; i++) {
+            Hit hit = hits[i];
+            hit.sample += l * loop_frames;
+            hits.push_back(hit);
+        }
+    }
+    uint64_t total = loop_frames * loops;
+
+    DSP.init(rate);
+    PathUI paths;
+    DSP.buildUserInterface(&paths);
+    FAUSTFLOAT *zones[SOUND_COUNT];
+    unsigned counts[SOUND_COUNT] = {0};
+    for (int s = 0; s < SOUND_COUNT; s++) {
+        std::string path = std::string("/drumkit/") + sound_names[s];
+        zones[s] = paths.zones.count(path) ? paths.zones[path] : NULL;
+        if (zones[s] == NULL) fprintf(stderr, "No control %s, its hits are left out\n", path.c_str());
+    }
+
+    int channels = DSP.getNumOutputs();
+    if (channels > MAX_OUTPUTS) channels = MAX_OUTPUTS;
+    static FAUSTFLOAT buffers[MAX_OUTPUTS][MAX_BLOCK];
+    FAUSTFLOAT *outputs[MAX_OUTPUTS];
+    for (int c = 0; c < MAX_OUTPUTS; c++) outputs[c] = buffers[c];
+
+    // The RIFF sizes are 32 bit: a longer render is only benchmarked
+    uint64_t data_bytes = total * channels * (pcm16 ? 2 : 4);
+    FILE *wav = NULL;
+    if (optind + 1 < argc && data_bytes > UINT32_MAX - 36) {
+        fprintf(stderr, "%llu bytes of audio do not fit a WAV file, %s not written\n",
+                (unsigned long long)data_bytes, argv[optind + 1]);
+    } else if (optind + 1 < argc) {
+        wav = fopen(argv[optind + 1], "wb");
+        if (wav == NULL) {
+            perror(argv[optind + 1]);
+            return 1;
+        }
+        wav_header(wav, channels, rate, pcm16, (uint32_t)data_bytes);
+    }
+    std::vector<float> frame_f(MAX_BLOCK * channels);
+    std::vector<int16_t> frame_i(MAX_BLOCK * channels);
+
+    // FNV-1a over the float samples, interleaved
+    uint64_t hash = 0xcbf29ce484222325ull;
+    uint64_t dsp_ns = 0;
+    uint64_t start = now_ns();
+    size_t next = 0;
+
+    for (uint64_t pos = 0; pos < total;) {
+        // Hits due here change their slider before the block
+        for (; next < hits.size() && hits[next].sample <= pos; next++) {
+            const Hit &hit = hits[next];
+            if (zones[hit.sound] == NULL) continue;
+            *zones[hit.sound] = sound_hit_value(counts[hit.sound]++, hit.velocity);
+        }
+        uint64_t n = total - pos < (uint64_t)block ? total - pos : block;
+        if (next < hits.size() && hits[next].sample - pos < n) n = hits[next].sample - pos;
+
+        uint64_t t = now_ns();
+        DSP.compute((int)n, NULL, outputs);
+        dsp_ns += now_ns() - t;
+
+        for (uint64_t i = 0; i < n; i++) {
+            for (int c = 0; c < channels; c++) {
+                float v = buffers[c][i];
+                uint32_t bits;
+                memcpy(&bits, &v, sizeof(bits));
+                for (int b = 0; b < 4; b++) {
+                    hash = (hash ^ ((bits >> (8 * b)) & 0xff)) * 0x100000001b3ull;
+                }
+                if (pcm16) {
+                    float clipped = v > 1.0f ? 1.0f : v < -1.0f ? -1.0f : v;
+                    frame_i[i * channels + c] = (int16_t)lrintf(clipped * 32767.0f);
+                } else {
+                    frame_f[i * channels + c] = v;
+                }
+            }
+        }
+        if (wav != NULL) {
+            if (pcm16) fwrite(frame_i.data(), sizeof(int16_t), n * channels, wav);
+            else fwrite(frame_f.data(), sizeof(float), n * channels, wav);
+        }
+        pos += n;
+    }
+    uint64_t wall_ns = now_ns() - start;
+
+    if (wav != NULL && fclose(wav) != 0) {
+        perror(argv[optind + 1]);
+        return 1;
+    }
+
+    double audio_s = (double)total / rate;
+    printf("%zu hits, %.2f s of audio at %d Hz in %.3f s: %.1fx real time (DSP alone %.1fx)\n", hits.size(),
+           audio_s, rate, wall_ns / 1e9, audio_s * 1e9 / wall_ns, dsp_ns ? audio_s * 1e9 / dsp_ns : 0.0);
+    printf("output hash %016llx\n", (unsigned long long)hash);
+    return 0;
+}
@@ -0,0 +1,323 @@
+// Metronome and backing patterns (src/seq_patterns.h) played by the audio
+// thread of the synth hosts in this directory. Steps are placed on exact
+// sample positions from a tempo map: compute() is cut at every step and
+// the hit sliders change before the part after it, the same trick as
+// render.cpp, so the timing does not depend on the period or on any
+// thread waking up in time. The click is mixed into every output.
+//
+// OSC, on the port of osc_control.h:
+//   /seq/run i        1 starts from bar 0 at the next block, 0 stops
+//   /seq/pattern i    pattern number, from the next bar
+//   /seq/tempo f      constant BPM from the next step
+//   /seq/map [i|f f]  tempo map, pairs of bar (from /seq/run 1) and BPM.
+//                     The tempo ramps linearly between points, two
+//                     points on the same bar jump, the last one holds
+//   /seq/click f      click level 0-1, 0 mutes it
+//
+// A step plays a sound like a hit from the controller (sound_hit_value)
+// on its own hit control (SEQ_HIT_PREFIX), written by nothing else.
+// Needs osc_control.h included first
+
+#ifndef SEQUENCER_H
+#define SEQUENCER_H
+
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <atomic>
+
+#include "seq_patterns.h"
+#include "sounds.h"
+
+#define SEQ_QUEUE_SIZE        64
+#define SEQ_MAX_TEMPO_POINTS  16
+#define SEQ_MAX_OUTPUTS       8
+
+// Click: a decaying sine, higher on the first beat of the bar
+#define SEQ_CLICK_HZ          1000
+#define SEQ_CLICK_ACCENT_HZ   1500
+#define SEQ_CLICK_MS          30
+#define SEQ_CLICK_DECAY_MS    6
+#define SEQ_CLICK_MAX_RATE    192000
+#define SEQ_CLICK_MAX_LEN     (SEQ_CLICK_MAX_RATE * SEQ_CLICK_MS / 1000)
+#define SEQ_DEFAULT_CLICK     0.5f
+
+enum SeqCommand { SEQ_RUN, SEQ_PATTERN, SEQ_CLICK };
+
+struct SeqChange {
+    SeqCommand command;
+    int i;
+    float f;
+};
+
+struct SeqTempoPoint {
+    float bar;
+    float bpm;
+};
+
+struct SeqTempoMap {
+    int num_points;
+    SeqTempoPoint points[SEQ_MAX_TEMPO_POINTS];
+};
+
+// Audio thread state
+static struct {
+    double rate;
+    int hit_ids[SOUND_COUNT];   // control ids (osc_control.h), -1 if missing
+    unsigned hit_count[SOUND_COUNT];
+    uint16_t steps[SEQ_NUM_PATTERNS][SOUND_COUNT];
+    uint16_t accents[SEQ_NUM_PATTERNS][SOUND_COUNT];
+
+    bool running;
+    int pattern;
+    int next_pattern;
+    SeqTempoMap map;
+    uint64_t sample;    // first sample of the block being computed
+    uint64_t step;      // steps since /seq/run 1
+    double step_at;     // sample of that step, fractional
+
+    float click_level;
+    const float *click;
+    int click_pos;
+} seq;
+
+static float seq_click_table[2][SEQ_CLICK_MAX_LEN];
+static int seq_click_len;
+
+// Simple changes, from the liblo thread like ctrl_queue
+static SeqChange seq_queue[SEQ_QUEUE_SIZE];
+static std::atomic<unsigned> seq_head(0);
+static std::atomic<unsigned> seq_tail(0);
+
+// A new tempo map is handed over whole: the liblo thread fills
+// seq_map_next while seq_map_ready is false, the audio thread copies it
+// and clears the flag
+static SeqTempoMap seq_map_next;
+static std::atomic<bool> seq_map_ready(false);
+
+// BPM of a step: linear between the points around its bar
+static double seq_bpm(const SeqTempoMap &map, uint64_t step) {
+    double bar = (double)step / SEQ_STEPS;
+    const SeqTempoPoint *p = map.points;
+    int n = map.num_points;
+
+    if (bar <= p[0].bar) return p[0].bpm;
+    for (int i = 1; i < n; i++) {
+        if (bar < p[i].bar) {
+            double x = (bar - p[i - 1].bar) / (p[i].bar - p[i - 1].bar);
+            return p[i - 1].bpm + x * (p[i].bpm - p[i - 1].bpm);
+        }
+    }
+    return p[n - 1].bpm;
+}
+
+static void seq_set_tempo(SeqTempoMap &map, float bpm) {
+    map.num_points = 1;
+    map.points[0].bar = 0;
+    map.points[0].bpm = bpm;
+}
+
+// Audio thread, at the start of a cycle
+static void sequencer_apply() {
+    if (seq_map_ready.load(std::memory_order_acquire)) {
+        seq.map = seq_map_next;
+        seq_map_ready.store(false, std::memory_order_release);
+    }
+
+    unsigned tail = seq_tail.load(std::memory_order_relaxed);
+    unsigned head = seq_head.load(std::memory_order_acquire);
+    for (; tail != head; tail++) {
+        const SeqChange &c = seq_queue[tail % SEQ_QUEUE_SIZE];
+        switch (c.command) {
+        case SEQ_RUN:
+            if (c.i && !seq.running) {
+                seq.step = 0;
+                seq.step_at = (double)seq.sample;
+            }
+            seq.running = c.i != 0;
+            break;
+        case SEQ_PATTERN:
+            seq.next_pattern = c.i;
+            break;
+        case SEQ_CLICK:
+            seq.click_level = c.f;
+            break;
+        }
+    }
+    seq_tail.store(tail, std::memory_order_release);
+}
+
+// Plays the step due now and moves to the next one
+static void seq_fire_step() {
+    int k = seq.step % SEQ_STEPS;
+    if (k == 0) seq.pattern = seq.next_pattern;
+
+    for (int s = 0; s < SOUND_COUNT; s++) {
+        int id = seq.hit_ids[s];
+        if (id < 0 || ctrl_live->zones[id] == NULL || !(seq.steps[seq.pattern][s] & (1u << k))) continue;
+        float velocity = seq.accents[seq.pattern][s] & (1u << k) ? SEQ_ACCENT_VELOCITY : SEQ_VELOCITY;
+        osc_control_write(id, sound_hit_value(seq.hit_count[s]++, velocity));
+    }
+    if (k % SEQ_STEPS_PER_BEAT == 0 && seq.click_level > 0) {
+        seq.click = seq_click_table[k == 0 ? 1 : 0];
+        seq.click_pos = 0;
+    }
+
+    seq.step_at += seq.rate * 60.0 / (seq_bpm(seq.map, seq.step) * SEQ_STEPS_PER_BEAT);
+    seq.step++;
+}
+
+static void seq_mix_click(FAUSTFLOAT **outputs, int num_outputs, int frames) {
+    if (seq.click == NULL) return;
+
+    int n = seq_click_len - seq.click_pos;
+    if (n > frames) n = frames;
+    const float *src = seq.click + seq.click_pos;
+    for (int c = 0; c < num_outputs; c++) {
+        for (int i = 0; i < n; i++) outputs[c][i] += seq.click_level * src[i];
+    }
+    seq.click_pos += n;
+    if (seq.click_pos == seq_click_len) seq.click = NULL;
+}
+
+// Runs compute for the cycle, cut at every step that falls in it
+static void sequencer_compute(void (*compute)(int, FAUSTFLOAT **), int frames, FAUSTFLOAT **outputs,
+                              int num_outputs) {
+    sequencer_apply();
+
+    FAUSTFLOAT *part[SEQ_MAX_OUTPUTS];
+    for (int pos = 0; pos < frames;) {
+        int n = frames - pos;
+        if (seq.running) {
+            uint64_t now = seq.sample + pos;
+            while ((uint64_t)seq.step_at <= now) seq_fire_step();
+            uint64_t next = (uint64_t)seq.step_at;
+            if (next - now < (uint64_t)n) n = (int)(next - now);
+        }
+
+        for (int c = 0; c < num_outputs && c < SEQ_MAX_OUTPUTS; c++) part[c] = outputs[c] + pos;
+        compute(n, part);
+        seq_mix_click(part, num_outputs, n);
+        pos += n;
+    }
+    seq.sample += frames;
+}
+
+static int seq_push(SeqCommand command, int i, float f) {
+    unsigned head = seq_head.load(std::memory_order_relaxed);
+    if (head - seq_tail.load(std::memory_order_acquire) >= SEQ_QUEUE_SIZE) {
+        fprintf(stderr, "sequencer queue full, command dropped\n");
+        return 0;
+    }
+    SeqChange &c = seq_queue[head % SEQ_QUEUE_SIZE];
+    c.command = command;
+    c.i = i;
+    c.f = f;
+    seq_head.store(head + 1, std::memory_order_release);
+    return 0;
+}
+
+// Hands a tempo map over, waiting (outside the audio thread) for the
+// previous one to be taken
+static void seq_push_map(const SeqTempoMap &map) {
+    for (int tries = 0; seq_map_ready.load(std::memory_order_acquire); tries++) {
+        if (tries == 100) {
+            fprintf(stderr, "sequencer not running, tempo map dropped\n");
+            return;
+        }
+        usleep(1000);
+    }
+    seq_map_next = map;
+    seq_map_ready.store(true, std::memory_order_release);
+}
+
+static float seq_clamp_bpm(float bpm) {
+    return bpm < SEQ_MIN_BPM ? SEQ_MIN_BPM : bpm > SEQ_MAX_BPM ? SEQ_MAX_BPM : bpm;
+}
+
+static int seq_run_message(const char *, const char *, lo_arg **argv, int, lo_message, void *) {
+    return seq_push(SEQ_RUN, argv[0]->i, 0);
+}
+
+static int seq_pattern_message(const char *, const char *, lo_arg **argv, int, lo_message, void *) {
+    if (argv[0]->i < 0 || argv[0]->i >= SEQ_NUM_PATTERNS) {
+        fprintf(stderr, "no sequencer pattern %d\n", argv[0]->i);
+        return 0;
+    }
+    return seq_push(SEQ_PATTERN, argv[0]->i, 0);
+}
+
+static int seq_click_message(const char *, const char *, lo_arg **argv, int, lo_message, void *) {
+    float level = argv[0]->f;
+    return seq_push(SEQ_CLICK, 0, level < 0 ? 0 : level > 1 ? 1 : level);
+}
+
+static int seq_tempo_message(const char *, const char *, lo_arg **argv, int, lo_message, void *) {
+    SeqTempoMap map;
+    seq_set_tempo(map, seq_clamp_bpm(argv[0]->f));
+    seq_push_map(map);
+    return 0;
+}
+
+static int seq_map_message(const char *, const char *types, lo_arg **argv, int argc, lo_message, void *) {
+    SeqTempoMap map;
+    map.num_points = 0;
+    if (argc == 0 || argc % 2 != 0 || argc / 2 > SEQ_MAX_TEMPO_POINTS) {
+        fprintf(stderr, "/seq/map takes 1 to %d bar, bpm pairs\n", SEQ_MAX_TEMPO_POINTS);
+        return 0;
+    }
+    for (int a = 0; a < argc; a += 2) {
+        if ((types[a] != 'i' && types[a] != 'f') || types[a + 1] != 'f') {
+            fprintf(stderr, "/seq/map pairs are (int or float) bar, float bpm\n");
+            return 0;
+        }
+        SeqTempoPoint &p = map.points[map.num_points];
+        p.bar = types[a] == 'i' ? argv[a]->i : argv[a]->f;
+        p.bpm = seq_clamp_bpm(argv[a + 1]->f);
+        if (p.bar < 0 || (map.num_points > 0 && p.bar < map.points[map.num_points - 1].bar)) {
+            fprintf(stderr, "/seq/map bars must not go backwards\n");
+            return 0;
+        }
+        map.num_points++;
+    }
+    seq_push_map(map);
+    return 0;
+}
+
+// Pattern grids and click tables for the rate, the ids of the step sounds
+// from the controls osc_control_start collected, and the /seq methods.
+// Before osc_control_listen
+static void sequencer_start(int rate) {
+    seq.rate = rate;
+    seq.click_level = SEQ_DEFAULT_CLICK;
+    seq_set_tempo(seq.map, SEQ_DEFAULT_BPM);
+
+    for (int s = 0; s < SOUND_COUNT; s++) {
+        seq.hit_ids[s] = osc_control_find(std::string(SEQ_HIT_PREFIX) + sound_names[s]);
+    }
+    for (int p = 0; p < SEQ_NUM_PATTERNS; p++) {
+        for (int s = 0; s < SOUND_COUNT; s++) {
+            const char *grid = seq_pattern_grids[p][s];
+            for (int k = 0; grid != NULL && k < SEQ_STEPS && grid[k]; k++) {
+                if (grid[k] == 'x' || grid[k] == 'X') seq.steps[p][s] |= 1u << k;
+                if (grid[k] == 'X') seq.accents[p][s] |= 1u << k;
+            }
+        }
+    }
+
+    seq_click_len = (rate < SEQ_CLICK_MAX_RATE ? rate : SEQ_CLICK_MAX_RATE) * SEQ_CLICK_MS / 1000;
+    for (int i = 0; i < seq_click_len; i++) {
+        double t = (double)i / rate;
+        double env = exp(-t * 1000.0 / SEQ_CLICK_DECAY_MS);
+        seq_click_table[0][i] = (float)(env * sin(2 * M_PI * SEQ_CLICK_HZ * t));
+        seq_click_table[1][i] = (float)(env * sin(2 * M_PI * SEQ_CLICK_ACCENT_HZ * t));
+    }
+
+    lo_server_thread_add_method(osc_thread, SEQ_PATH_RUN, "i", seq_run_message, NULL);
+    lo_server_thread_add_method(osc_thread, SEQ_PATH_PATTERN, "i", seq_pattern_message, NULL);
+    lo_server_thread_add_method(osc_thread, SEQ_PATH_CLICK, "f", seq_click_message, NULL);
+    lo_server_thread_add_method(osc_thread, SEQ_PATH_TEMPO, "f", seq_tempo_message, NULL);
+    lo_server_thread_add_method(osc_thread, SEQ_PATH_MAP, NULL, seq_map_message, NULL);
+}
+
+#endif
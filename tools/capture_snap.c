@@ -0,0 +1,157 @@
+// Copies frames out of a running DRUM_CAPTURE ring (src/capture.h) as
+// CSV, built by `make capture-snap`.
+//
+//   drum_capture_snap [-b seconds] [-a seconds] [-w] ring_file > frames.csv
+//
+// Without -w: the last -b seconds (default 2). With -w: waits for the next
+// hit and writes -b seconds before it to -a seconds (default 1) after it.
+// One line per frame: time in ms (from the hit with -w, else from the
+// first line), the hit mask, then every input in mV, empty when the input
+// was not sampled in that frame
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "capture.h"
+
+#define SNAP_POLL_US 10000
+
+static const CapHeader *header;
+static const uint8_t *ring;
+
+static const CapFrame *frame_at(unsigned n) {
+    return (const CapFrame *)(ring + (size_t)(n & (header->capacity - 1)) * header->frame_size);
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-b seconds] [-a seconds] [-w] ring_file\n", name);
+}
+
+int main(int argc, char *argv[]) {
+    double before = 2.0, after = 1.0;
+    bool wait_hit = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:a:w")) != -1) {
+        switch (opt) {
+        case 'b': before = atof(optarg); break;
+        case 'a': after = atof(optarg); break;
+        case 'w': wait_hit = true; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const char *path = argv[optind];
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(path);
+        return 1;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror(path);
+        return 1;
+    }
+    header = map;
+    if ((size_t)st.st_size < sizeof(CapHeader) || memcmp(header->magic, CAP_MAGIC, sizeof(CAP_MAGIC)) != 0 ||
+        header->version != CAP_VERSION ||
+        (size_t)st.st_size < header->data_offset + (size_t)header->capacity * header->frame_size) {
+        fprintf(stderr, "%s is not a version %d capture ring\n", path, CAP_VERSION);
+        return 1;
+    }
+    ring = (const uint8_t *)map + header->data_offset;
+    int num_inputs = header->num_inputs;
+
+    // Frame the window ends at, and its time
+    unsigned end;
+    uint64_t from_ns, to_ns, t0 = 0;
+    if (wait_hit) {
+        unsigned hit = atomic_load_explicit(&header->last_hit, memory_order_acquire);
+        while (atomic_load_explicit(&header->last_hit, memory_order_acquire) == hit) {
+            usleep(SNAP_POLL_US);
+        }
+        hit = atomic_load_explicit(&header->last_hit, memory_order_acquire);
+        uint64_t hit_ns = frame_at(hit - 1)->t_ns;
+        t0 = hit_ns;
+        from_ns = hit_ns > before * 1e9 ? hit_ns - (uint64_t)(before * 1e9) : 0;
+        to_ns = hit_ns + (uint64_t)(after * 1e9);
+        // Until the capture is past the end of the window
+        do {
+            usleep(SNAP_POLL_US);
+            end = atomic_load_explicit(&header->frames, memory_order_acquire);
+        } while (frame_at(end - 1)->t_ns < to_ns);
+    } else {
+        end = atomic_load_explicit(&header->frames, memory_order_acquire);
+        if (end == 0) {
+            fprintf(stderr, "No frames captured yet\n");
+            return 1;
+        }
+        to_ns = frame_at(end - 1)->t_ns;
+        from_ns = to_ns > before * 1e9 ? to_ns - (uint64_t)(before * 1e9) : 0;
+    }
+
+    // Copy of the whole ring, oldest first, then what was overwritten
+    // while copying is left out
+    unsigned avail = end < header->capacity ? end : header->capacity - 1;
+    uint8_t *copy = malloc((size_t)avail * header->frame_size);
+    if (copy == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (unsigned i = 0; i < avail; i++) {
+        memcpy(copy + (size_t)i * header->frame_size, frame_at(end - avail + i), header->frame_size);
+    }
+    // Frame n overwrites n - capacity, the frames written meanwhile took
+    // the oldest ones of the copy
+    unsigned now = atomic_load_explicit(&header->frames, memory_order_acquire);
+    long skip = (long)(now - end) - (long)(header->capacity - 1 - avail);
+    unsigned first = skip < 0 ? 0 : skip < avail ? (unsigned)skip : avail;
+    if (first > 0) {
+        fprintf(stderr, "%u frames overwritten while copying\n", first);
+    }
+
+    printf("t_ms,hits");
+    for (int i = 0; i < num_inputs; i++) printf(",in%d_mv", i + 1);
+    printf("\n");
+
+    unsigned lines = 0;
+    uint64_t first_ns = 0, last_ns = 0;
+    for (unsigned i = first; i < avail; i++) {
+        const CapFrame *f = (const CapFrame *)(copy + (size_t)i * header->frame_size);
+        if (f->t_ns < from_ns || f->t_ns > to_ns) continue;
+        if (lines++ == 0) {
+            first_ns = f->t_ns;
+            if (!wait_hit) t0 = f->t_ns;
+        }
+        last_ns = f->t_ns;
+
+        printf("%.3f,%x", ((int64_t)f->t_ns - (int64_t)t0) / 1e6, f->hits);
+        for (int in = 0; in < num_inputs; in++) {
+            if (f->fresh & (1u << in)) {
+                printf(",%.3f", f->data[in] * (uint16_t)f->data[num_inputs + in] / 32768.0);
+            } else {
+                printf(",");
+            }
+        }
+        printf("\n");
+    }
+    fprintf(stderr, "%u frames, %.3f s\n", lines, (last_ns - first_ns) / 1e9);
+
+    free(copy);
+    return 0;
+}
@@ -0,0 +1,346 @@
+/*
+ * latency.c
+ *
+ * End-to-end latency of the trigger chain on any Linux machine, without
+ * the board: synthetic piezo hits from the replay ADC backend go through
+ * the trigger detection and the OSC output of the app to the synth, its
+ * sound comes back through the snd-aloop loopback card and the onset in
+ * it is timed against the first ADC sample of the hit.
+ *
+ *   modprobe snd-aloop
+ *   build/bin/drumkit_alsa -d hw:Loopback,0,0 &
+ *   build/bin/drum_latency [-c capture_device] [-n hits] [-i ms] [-p peak] [-l level] [-d host:port]
+ *
+ * Every pad of the topology (DRUM_TOPOLOGY) is hit -n times, one hit
+ * every -i ms, round robin. The onset is the first captured sample over
+ * -l (full scale 1) and over twice the level just before the hit. Per
+ * pad: hits detected, latency mean, min, median, 95th percentile, max and
+ * the jitter (standard deviation). Linked against the app like the
+ * bench, built by `make latency`.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <alsa/asoundlib.h>
+
+#include "src/topology.h"
+#include "src/controller.h"
+#include "src/calibration.h"
+#include "src/ads_replay.h"
+#include "src/trigger_out.h"
+
+#define LAT_DEFAULT_DEVICE   "hw:Loopback,1,0"
+#define LAT_DEFAULT_HITS     20
+#define LAT_DEFAULT_INTERVAL 300
+#define LAT_DEFAULT_PEAK     20000
+#define LAT_DEFAULT_LEVEL    0.02f
+#define LAT_RATE             48000
+#define LAT_PERIOD           64
+#define LAT_MAX_CHANNELS     8
+#define LAT_PRE_MS           5      // level before the hit, to leave ring-outs out
+#define LAT_MAX_MS           250    // no onset this long after the hit: lost
+#define LAT_LEAD_MS          200    // hits go into the replay queue this early
+
+typedef struct {
+    int input;
+    uint64_t t_ns;          // first ADC sample of the hit
+    bool triggered;         // the trigger detection saw it
+    double latency_ms;      // to the onset, < 0 when none was found
+} LatHit;
+
+// Time of the last sample of every capture read
+typedef struct {
+    uint64_t end;           // index after the last sample
+    uint64_t t_ns;
+} LatRead;
+
+static snd_pcm_t *pcm;
+static snd_pcm_format_t format;
+static unsigned channels;
+
+// Captured audio, the loudest channel of every frame
+static float *audio;
+static uint64_t audio_cap;
+static LatRead *reads;
+static uint64_t reads_cap;
+static atomic_ullong audio_len;
+static uint64_t num_reads;
+static atomic_bool capturing;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// The formats drumkit_alsa tries, in its order: both ends of the loopback must agree
+static int open_capture(const char *device) {
+    static const snd_pcm_format_t formats[] = {SND_PCM_FORMAT_FLOAT_LE, SND_PCM_FORMAT_S32_LE, SND_PCM_FORMAT_S16_LE};
+    int err = snd_pcm_open(&pcm, device, SND_PCM_STREAM_CAPTURE, 0);
+    if (err < 0) {
+        fprintf(stderr, "%s: %s (modprobe snd-aloop?)\n", device, snd_strerror(err));
+        return -1;
+    }
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        err = snd_pcm_set_params(pcm, formats[f], SND_PCM_ACCESS_RW_INTERLEAVED, channels, LAT_RATE, 0,
+                                 LAT_PERIOD * 4 * 1000000ull / LAT_RATE);
+        if (err == 0) {
+            format = formats[f];
+            return 0;
+        }
+    }
+    fprintf(stderr, "%s: no capture format: %s\n", device, snd_strerror(err));
+    return -1;
+}
+
+static float sample_at(const void *buf, size_t i) {
+    switch (format) {
+    case SND_PCM_FORMAT_FLOAT_LE: return ((const float *)buf)[i];
+    case SND_PCM_FORMAT_S32_LE:   return ((const int32_t *)buf)[i] / 2147483648.0f;
+    default:                      return ((const int16_t *)buf)[i] / 32768.0f;
+    }
+}
+
+static void *capture_thread(void *arg) {
+    static int32_t buf[LAT_PERIOD * LAT_MAX_CHANNELS];
+
+    while (atomic_load(&capturing)) {
+        snd_pcm_sframes_t n = snd_pcm_readi(pcm, buf, LAT_PERIOD);
+        uint64_t t = now_ns();
+        if (n < 0) {
+            fprintf(stderr, "capture: %s\n", snd_strerror((int)n));
+            snd_pcm_recover(pcm, (int)n, 1);
+            continue;
+        }
+        // What the card holds beyond this read was captured after its last sample
+        snd_pcm_sframes_t queued = snd_pcm_avail(pcm);
+        if (queued < 0) queued = 0;
+
+        uint64_t len = atomic_load_explicit(&audio_len, memory_order_relaxed);
+        if (len + n > audio_cap || num_reads == reads_cap) {
+            break;
+        }
+        for (snd_pcm_sframes_t i = 0; i < n; i++) {
+            float peak = 0;
+            for (unsigned c = 0; c < channels; c++) {
+                float v = fabsf(sample_at(buf, i * channels + c));
+                if (v > peak) peak = v;
+            }
+            audio[len + i] = peak;
+        }
+        reads[num_reads].end = len + n;
+        reads[num_reads].t_ns = t - (uint64_t)queued * 1000000000ull / LAT_RATE;
+        num_reads++;
+        atomic_store_explicit(&audio_len, len + n, memory_order_release);
+    }
+    return NULL;
+}
+
+// Capture time of audio sample i, from the read it came in
+static uint64_t sample_time(uint64_t i) {
+    uint64_t lo = 0, hi = num_reads;
+    while (lo < hi) {
+        uint64_t mid = (lo + hi) / 2;
+        if (reads[mid].end <= i) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == num_reads) return UINT64_MAX;
+    return reads[lo].t_ns - (reads[lo].end - 1 - i) * 1000000000ull / LAT_RATE;
+}
+
+// First sample captured at t_ns or later
+static uint64_t sample_index(uint64_t t_ns) {
+    uint64_t lo = 0, hi = atomic_load(&audio_len);
+    while (lo < hi) {
+        uint64_t mid = (lo + hi) / 2;
+        if (sample_time(mid) < t_ns) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static double find_onset(const LatHit *hit, float level) {
+    uint64_t len = atomic_load(&audio_len);
+    uint64_t start = sample_index(hit->t_ns);
+    uint64_t pre = sample_index(hit->t_ns - LAT_PRE_MS * 1000000ull);
+    uint64_t end = sample_index(hit->t_ns + LAT_MAX_MS * 1000000ull);
+    if (end > len) end = len;
+
+    float before = 0;
+    for (uint64_t i = pre; i < start; i++) {
+        if (audio[i] > before) before = audio[i];
+    }
+    float threshold = 2 * before > level ? 2 * before : level;
+    for (uint64_t i = start; i < end; i++) {
+        if (audio[i] > threshold) return (sample_time(i) - hit->t_ns) / 1e6;
+    }
+    return -1;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void report(const LatHit *hits, int num_hits, int input, const char *name) {
+    double *lat = malloc(num_hits * sizeof(double));
+    int n = 0, triggered = 0, total = 0;
+
+    for (int i = 0; i < num_hits; i++) {
+        if (input >= 0 && hits[i].input != input) continue;
+        total++;
+        if (hits[i].triggered) triggered++;
+        if (hits[i].latency_ms >= 0) lat[n++] = hits[i].latency_ms;
+    }
+    if (n == 0) {
+        printf("%-14s %d/%d triggered, no onsets found\n", name, triggered, total);
+        free(lat);
+        return;
+    }
+    qsort(lat, n, sizeof(lat[0]), compare_double);
+    double sum = 0, sq = 0;
+    for (int i = 0; i < n; i++) sum += lat[i];
+    double mean = sum / n;
+    for (int i = 0; i < n; i++) sq += (lat[i] - mean) * (lat[i] - mean);
+
+    printf("%-14s %d/%d triggered, %d onsets: mean %.2f min %.2f p50 %.2f p95 %.2f max %.2f ms, jitter %.2f ms\n",
+           name, triggered, total, n, mean, lat[0], lat[n / 2], lat[(n * 95) / 100 < n ? (n * 95) / 100 : n - 1],
+           lat[n - 1], sqrt(sq / n));
+    free(lat);
+}
+
+int main(int argc, char *argv[]) {
+    const char *device = LAT_DEFAULT_DEVICE;
+    const char *dest = NULL;
+    int hits_per_pad = LAT_DEFAULT_HITS;
+    int interval_ms = LAT_DEFAULT_INTERVAL;
+    int peak = LAT_DEFAULT_PEAK;
+    float level = LAT_DEFAULT_LEVEL;
+    int opt;
+
+    channels = 2;
+    while ((opt = getopt(argc, argv, "c:C:n:i:p:l:d:")) != -1) {
+        switch (opt) {
+        case 'c': device = optarg; break;
+        case 'C': channels = atoi(optarg); break;
+        case 'n': hits_per_pad = atoi(optarg); break;
+        case 'i': interval_ms = atoi(optarg); break;
+        case 'p': peak = atoi(optarg); break;
+        case 'l': level = atof(optarg); break;
+        case 'd': dest = optarg; break;
+        default:
+            fprintf(stderr, "usage: %s [-c capture_device] [-C channels] [-n hits] [-i ms] [-p peak] [-l level] "
+                    "[-d host:port]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (channels < 1 || channels > LAT_MAX_CHANNELS || hits_per_pad < 1 || interval_ms < 1) {
+        fprintf(stderr, "bad arguments\n");
+        return 1;
+    }
+
+    // The app's trigger side, as main() sets it up for DRUM_ADC=replay
+    const char *topo = getenv("DRUM_TOPOLOGY");
+    topology_init(topo ? topo : TOPO_DEFAULT_FILE);
+    controller_init();
+    const char *cal = getenv("DRUM_CAL_FILE");
+    calibration_init(cal ? cal : CAL_DEFAULT_FILE);
+    for (int i = 0; i < topology.num_inputs; i++) {
+        uint16_t fsr = topology.inputs[i].fsr_mv;
+        calibration_set_scale(i, (float)TOPO_DEFAULT_FSR_MV / (fsr ? fsr : TOPO_DEFAULT_FSR_MV));
+    }
+    if (ads_replay_init(NULL) < 0 || trigger_out_init("osc", dest) < 0) {
+        return 1;
+    }
+
+    int pads[TOPO_MAX_INPUTS], num_pads = 0;
+    for (int i = 0; i < topology.num_inputs; i++) {
+        if (topology.inputs[i].channel >= 0) pads[num_pads++] = i;
+    }
+    int num_hits = hits_per_pad * num_pads;
+    LatHit *hits = calloc(num_hits, sizeof(LatHit));
+
+    uint64_t duration_ns = (uint64_t)(num_hits + 1) * interval_ms * 1000000ull + 1000000000ull;
+    audio_cap = duration_ns * LAT_RATE / 1000000000ull + LAT_RATE;
+    reads_cap = audio_cap / LAT_PERIOD * 2 + 16;
+    audio = malloc(audio_cap * sizeof(float));
+    reads = malloc(reads_cap * sizeof(LatRead));
+    if (hits == NULL || audio == NULL || reads == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    if (open_capture(device) < 0) {
+        return 1;
+    }
+    pthread_t thread;
+    atomic_store(&capturing, true);
+    if (pthread_create(&thread, NULL, capture_thread, NULL) != 0) {
+        fprintf(stderr, "Can not start the capture thread\n");
+        return 1;
+    }
+    struct sched_param param = {.sched_priority = sched_get_priority_max(SCHED_FIFO) / 2};
+    if (pthread_setschedparam(thread, SCHED_FIFO, &param) != 0) {
+        fprintf(stderr, "No SCHED_FIFO for the capture, its timestamps will be noisier\n");
+    }
+
+    // First hit after the capture is running and the rest level is known
+    uint64_t start_ns = now_ns() + 500000000ull;
+    for (int k = 0; k < num_hits; k++) {
+        hits[k].input = pads[k % num_pads];
+        hits[k].t_ns = start_ns + (uint64_t)k * interval_ms * 1000000ull;
+        hits[k].latency_ms = -1;
+    }
+    printf("%d pads x %d hits, one every %d ms, capturing %s\n", num_pads, hits_per_pad, interval_ms, device);
+
+    // The app's acquisition loop, on replay frames
+    int16_t values[TOPO_MAX_INPUTS] = {0};
+    int queued = 0;
+    uint64_t end_ns = hits[num_hits - 1].t_ns + LAT_MAX_MS * 1000000ull + 100000000ull;
+    while (now_ns() < end_ns) {
+        for (; queued < num_hits && hits[queued].t_ns < now_ns() + LAT_LEAD_MS * 1000000ull; queued++) {
+            ads_replay_hit(hits[queued].input, hits[queued].t_ns, peak);
+        }
+        int fresh = ads_replay_frame(values);
+        uint32_t triggered = process_ads_triggers(values, fresh);
+        // A trigger belongs to the last hit of its pad that started
+        uint64_t now = now_ns();
+        for (int k = queued - 1; triggered && k >= 0; k--) {
+            if ((triggered & (1u << hits[k].input)) && hits[k].t_ns <= now) {
+                hits[k].triggered = true;
+                triggered &= ~(1u << hits[k].input);
+            }
+        }
+    }
+
+    atomic_store(&capturing, false);
+    pthread_join(thread, NULL);
+    snd_pcm_close(pcm);
+    trigger_out_close();
+
+    for (int k = 0; k < num_hits; k++) {
+        hits[k].latency_ms = find_onset(&hits[k], level);
+    }
+    printf("\nLatency from the first ADC sample of the hit to the onset in the capture:\n");
+    for (int p = 0; p < num_pads; p++) {
+        char name[32];
+        int input = pads[p];
+        snprintf(name, sizeof(name), "in%d %s", input, sound_names[channel_sound(topology.inputs[input].channel)]);
+        report(hits, num_hits, input, name);
+    }
+    report(hits, num_hits, -1, "all");
+
+    free(hits);
+    free(audio);
+    free(reads);
+    return 0;
+}
@@ -0,0 +1,212 @@
+// Plays a trigger recording (DRUM_RECORD, src/recorder.h) back into the
+// OSC or MIDI trigger output, built by `make replay`.
+//
+//   drum_replay [-o osc|midi] [-d dest] [-s speed] [-l loops] file
+//
+// -o and -d are DRUM_OUTPUT and DRUM_OUTPUT_DEST of the app, -s plays
+// faster (2) or slower (0.5), -l repeats the file (0 forever). The hits
+// of one recorded frame leave in one flush like they did live. Every
+// session of the file starts REPLAY_SESSION_PAUSE_MS after the previous
+// one instead of after its lead-in. Over OSC the hits go to their own
+// controls (REC_HIT_PREFIX), a replay does not lose hits to the pads
+// played along with it.
+//
+// The tool sleeps until REPLAY_SPIN_US before a frame (more if the sleeps
+// overshoot) and spins on the clock from there, the report at the end
+// gives how late the frames went out
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+
+#include "recorder.h"
+#include "sounds.h"
+#include "trigger_out.h"
+
+#define REPLAY_SPIN_US          200
+#define REPLAY_SPIN_MAX_US      5000
+#define REPLAY_SESSION_PAUSE_MS 500
+
+static volatile sig_atomic_t running = 1;
+
+// Lateness of the flushes, from the frame time to the flush
+static uint64_t late_sum_ns;
+static uint64_t late_max_ns;
+static unsigned late_over_ms;
+static unsigned frames;
+static unsigned hits;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// Sleeps to spin_ns before due_ns, then spins. A sleep that overshoots
+// into the spin widens it, up to REPLAY_SPIN_MAX_US
+static void wait_until(uint64_t due_ns) {
+    static uint64_t spin_ns = REPLAY_SPIN_US * 1000ull;
+
+    if (due_ns > now_ns() + spin_ns) {
+        uint64_t wake_ns = due_ns - spin_ns;
+        struct timespec ts = {wake_ns / 1000000000ull, wake_ns % 1000000000ull};
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR && running) {
+        }
+        uint64_t over_ns = now_ns() - wake_ns + REPLAY_SPIN_US * 1000ull;
+        if (over_ns > spin_ns) {
+            spin_ns = over_ns < REPLAY_SPIN_MAX_US * 1000ull ? over_ns : REPLAY_SPIN_MAX_US * 1000ull;
+        }
+    }
+    while (now_ns() < due_ns) {
+    }
+}
+
+static void stop(int sig) {
+    running = 0;
+}
+
+// The whole file, header checked. Returns the records and their count
+static RecEvent *load(const char *path, size_t *count) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return NULL;
+    }
+
+    RecHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, REC_MAGIC, sizeof(REC_MAGIC)) != 0 ||
+        header.version != REC_VERSION || header.event_size != sizeof(RecEvent)) {
+        fprintf(stderr, "%s is not a version %d trigger recording\n", path, REC_VERSION);
+        fclose(f);
+        return NULL;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f) - (long)sizeof(header);
+    fseek(f, sizeof(header), SEEK_SET);
+
+    *count = size / sizeof(RecEvent);
+    RecEvent *events = malloc(*count * sizeof(RecEvent) + 1);
+    if (events == NULL || fread(events, sizeof(RecEvent), *count, f) != *count) {
+        fprintf(stderr, "%s: read error\n", path);
+        free(events);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    return events;
+}
+
+// One pass over the records from start_ns on, returns when it ended
+static uint64_t play(const RecEvent *events, size_t count, uint64_t start_ns, double speed) {
+    uint64_t t_ns = 0;          // recorded time since start_ns, lead-ins left out
+    bool lead_in = true;        // until the first hit of a session
+    bool played = false;
+    bool pending = false;       // hits held for the flush
+
+    for (size_t i = 0; i < count && running; i++) {
+        const RecEvent *ev = &events[i];
+
+        if (ev->flags & REC_FLAG_SESSION) {
+            lead_in = true;
+            continue;
+        }
+        if (lead_in) {
+            if (ev->flags & REC_FLAG_GAP) continue;
+            if (played) t_ns += REPLAY_SESSION_PAUSE_MS * 1000000ull;
+            lead_in = false;
+        } else {
+            t_ns += ev->delta_us * 1000ull;
+            if (ev->flags & REC_FLAG_GAP) continue;
+        }
+
+        if (!(ev->flags & REC_FLAG_FRAME)) {
+            // The previous frame leaves before this one is waited for
+            if (pending) trigger_out_flush();
+            pending = false;
+
+            uint64_t due_ns = start_ns + (uint64_t)(t_ns / speed);
+            wait_until(due_ns);
+            uint64_t late = now_ns() - due_ns;
+            late_sum_ns += late;
+            if (late > late_max_ns) late_max_ns = late;
+            if (late > 1000000) late_over_ms++;
+            frames++;
+        }
+        if (ev->sound < SOUND_COUNT) {
+            trigger_out_hit(ev->sound, ev->velocity / 255.0f);
+            pending = true;
+            played = true;
+            hits++;
+        }
+    }
+    if (pending) trigger_out_flush();
+    return start_ns + (uint64_t)(t_ns / speed);
+}
+
+int main(int argc, char *argv[]) {
+    const char *output = "osc";
+    const char *dest = NULL;
+    double speed = 1.0;
+    int loops = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:d:s:l:")) != -1) {
+        switch (opt) {
+        case 'o': output = optarg; break;
+        case 'd': dest = optarg; break;
+        case 's': speed = atof(optarg); break;
+        case 'l': loops = atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-o osc|midi] [-d dest] [-s speed] [-l loops] file\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc || speed <= 0) {
+        fprintf(stderr, "usage: %s [-o osc|midi] [-d dest] [-s speed] [-l loops] file\n", argv[0]);
+        return 1;
+    }
+
+    size_t count;
+    RecEvent *events = load(argv[optind], &count);
+    if (events == NULL) {
+        return 1;
+    }
+    trigger_osc_set_prefix(REC_HIT_PREFIX);
+    if (trigger_out_init(output, dest) < 0) {
+        return 1;
+    }
+
+    // Timing: no page faults, ahead of the other processes when allowed
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        perror("mlockall");
+    }
+    struct sched_param param = {.sched_priority = sched_get_priority_max(SCHED_FIFO) / 2};
+    if (sched_setscheduler(0, SCHED_FIFO, &param) < 0) {
+        perror("SCHED_FIFO (timing may suffer)");
+    }
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    printf("%zu records, playing to %s\n", count, output);
+    uint64_t start_ns = now_ns() + 100000000ull;
+    for (int loop = 0; (loops == 0 || loop < loops) && running; loop++) {
+        start_ns = play(events, count, start_ns, speed) + REPLAY_SESSION_PAUSE_MS * 1000000ull;
+    }
+
+    printf("%u hits in %u frames, late by %.1f us mean, %.1f us max, %u over 1 ms\n", hits, frames,
+           frames ? late_sum_ns / 1000.0 / frames : 0.0, late_max_ns / 1000.0, late_over_ms);
+
+    trigger_out_close();
+    free(events);
+    return 0;
+}